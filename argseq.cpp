@@ -0,0 +1,137 @@
+/*
+  argseq.cpp
+  S. Edward Dolan
+  Saturday, October 17 2026
+*/
+
+#include "sxp.hpp"
+
+ArgSeq* ArgSeq::create(Obj** args, int n) {
+    return new ArgSeq(args, n);
+}
+
+ArgSeq::ArgSeq(Obj** args, int n)
+    : _args(args),
+      _n(n),
+      _owner(this),
+      _i(0),
+      _nextOpen(nullptr),
+      _saved() {
+    _typeId = TID_ArgSeq;
+}
+
+ArgSeq::ArgSeq(ArgSeq* owner, int i)
+    : _args(nullptr),
+      _n(0),
+      _owner(owner),
+      _i(i),
+      _nextOpen(nullptr),
+      _saved() {
+    _typeId = TID_ArgSeq;
+}
+
+// copy the args off the VM's stack, every view of them follows
+void ArgSeq::close() {
+    _saved.assign(_args, _args + _n);
+    _args = _saved.data();
+}
+
+std::string ArgSeq::toString() {
+    std::stringstream ss;
+    ss << '(';
+    for (Obj** p=begin(); p!=end(); ++p)
+        ss << (p != begin() ? " " : "") << rt::toString(*p);
+    ss << ')';
+    return ss.str();
+}
+
+size_t ArgSeq::getHash() {
+    std::stringstream ss;
+    ss << typeName() << " is not hashable";
+    throw SxRuntimeError(ss.str());
+}
+
+// equal to a List, Vector, ArgSeq, or ASeq with equal elements
+bool ArgSeq::isEqualTo(Obj* obj) {
+    if (this == obj)
+        return true;
+    if (!pList(obj) && !pVector(obj) && !pArgSeq(obj) && !pASeq(obj))
+        return false;
+    Obj** p = begin();
+    for (SeqIter i(obj); i; ++i, ++p)
+        if (p == end() || !rt::isEqualTo(*p, *i))
+            return false;
+    return p == end();
+}
+
+// a List of the args, for when a list is what's wanted
+Obj* ArgSeq::copy() {
+    ISeq* s = List::create();
+    for (Obj** p=end(); p!=begin(); )
+        s = s->cons(*--p);
+    return s;
+}
+
+// =========================================================================
+// ISeq
+
+Obj* ArgSeq::first() {
+    return *begin();
+}
+
+ISeq* ArgSeq::rest() {
+    if (ISeq* s = next())
+        return s;
+    return List::create();
+}
+
+ISeq* ArgSeq::next() {
+    if (_i + 1 < _owner->_n)
+        return new ArgSeq(_owner, _i + 1);
+    return NIL;
+}
+
+ISeq* ArgSeq::cons(Obj* x) {
+    List* lst = List::create(x);
+    lst->_tail = this;
+    return lst;
+}
+
+// =========================================================================
+// ISeqable
+
+ISeq* ArgSeq::seq() {
+    return this;                // never empty, an empty rest arg is nil
+}
+
+// =========================================================================
+// IIndexed
+
+Obj* ArgSeq::nth(int i) {
+    if (i >= 0 && i < count())
+        return begin()[i];
+    std::stringstream ss;
+    ss << typeName() << " index (" << i << ") out of bounds";
+    throw SxOutOfBoundsError(ss.str());
+}
+
+Obj* ArgSeq::nth(int i, Obj* notFound) {
+    if (i >= 0 && i < count())
+        return begin()[i];
+    return notFound;
+}
+
+// =========================================================================
+// ICollection
+
+int ArgSeq::count() {
+    return _owner->_n - _i;
+}
+
+bool ArgSeq::isEmpty() {
+    return false;
+}
+
+ICollection* ArgSeq::conj(Obj* x) {
+    return pList(cons(x));
+}
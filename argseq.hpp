@@ -0,0 +1,83 @@
+/*
+  argseq.hpp
+  S. Edward Dolan
+  Saturday, October 17 2026
+*/
+
+#ifndef ARGSEQ_HPP_INCLUDED
+#define ARGSEQ_HPP_INCLUDED
+
+/*
+  The rest arg of a call, a view of the tail args where the caller pushed
+  them on the VM's stack (see VM::doCall()). When the frame is left the VM
+  close()s it, copying the args off the stack, so one that outlived the
+  call still sees them. next() and rest() make views of the same args.
+*/
+struct ArgSeq : ISeq, ISeqable, IIndexed, ICollection {
+    friend struct VM;
+    static ArgSeq* create(Obj** args, int n);
+    std::string toString();
+    size_t getHash();
+    bool isEqualTo(Obj*);
+    Obj* copy();
+    // the args of this view
+    Obj** begin() const { return _owner->_args + _i; }
+    Obj** end() const { return _owner->_args + _owner->_n; }
+    // ISeq
+    Obj* first();
+    ISeq* rest();
+    ISeq* next();
+    ISeq* cons(Obj*);
+    // ISeqable
+    ISeq* seq();
+    // IIndexed
+    Obj* nth(int);
+    Obj* nth(int, Obj*);
+    // ICollection
+    int count();
+    bool isEmpty();
+    ICollection* conj(Obj*);
+protected:
+    Obj** _args;                // on the stack, or in _saved once closed
+    int _n;                     // number of args
+    ArgSeq* _owner;             // the view made for the call, or this
+    int _i;                     // index of this view's first arg
+    ArgSeq* _nextOpen;          // the VM's next open ArgSeq, see close()
+    vecobj_t _saved;
+    ArgSeq(Obj** args, int n);
+    ArgSeq(ArgSeq* owner, int i);
+    void close();
+};
+DEF_CASTER(ArgSeq)
+
+/*
+  Walk a seq without making a view per element of an ArgSeq:
+
+    for (SeqIter i(coll); i; ++i)
+        f(*i);
+*/
+struct SeqIter {
+    SeqIter(Obj* x) : _p(nullptr), _end(nullptr), _s(NIL) {
+        if (ArgSeq* a = pArgSeq(x)) {
+            _p = a->begin();
+            _end = a->end();
+        }
+        else
+            _s = rt::seq(x);
+    }
+    explicit operator bool() const { return _p ? _p != _end : _s != NIL; }
+    Obj* operator*() const { return _p ? *_p : _s->first(); }
+    SeqIter& operator++() {
+        if (_p)
+            ++_p;
+        else
+            _s = _s->next();
+        return *this;
+    }
+private:
+    Obj** _p;
+    Obj** _end;
+    ISeq* _s;
+};
+
+#endif // ARGSEQ_HPP_INCLUDED
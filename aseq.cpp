@@ -0,0 +1,216 @@
+/*
+  aseq.cpp
+  S. Edward Dolan
+  Saturday, October 17 2026
+*/
+
+#include "sxp.hpp"
+
+std::string ASeq::toString() {
+    std::stringstream ss;
+    ss << '(';
+    for (ISeq* s=this; s; s=s->next())
+        ss << (s != this ? " " : "") << rt::toString(s->first());
+    ss << ')';
+    return ss.str();
+}
+
+size_t ASeq::getHash() {
+    std::stringstream ss;
+    ss << typeName() << " is not hashable";
+    throw SxRuntimeError(ss.str());
+}
+
+// equal to a List, Vector, ArgSeq, or ASeq with equal elements
+bool ASeq::isEqualTo(Obj* obj) {
+    if (this == obj)
+        return true;
+    if (!pList(obj) && !pVector(obj) && !pArgSeq(obj) && !pASeq(obj))
+        return false;
+    ISeq* s = this;
+    for (SeqIter i(obj); i; ++i, s=s->next())
+        if (!s || !rt::isEqualTo(s->first(), *i))
+            return false;
+    return !s;
+}
+
+// a List of the elements, for when a list is what's wanted
+Obj* ASeq::copy() {
+    vecobj_t v;
+    for (ISeq* s=this; s; s=s->next())
+        v.push_back(s->first());
+    return List::create(v);
+}
+
+// =========================================================================
+// ISeq
+
+ISeq* ASeq::rest() {
+    if (ISeq* s = next())
+        return s;
+    return List::create();
+}
+
+ISeq* ASeq::cons(Obj* x) {
+    List* lst = List::create(x);
+    lst->_tail = this;
+    return lst;
+}
+
+// =========================================================================
+// ISeqable
+
+ISeq* ASeq::seq() {
+    return this;
+}
+
+// =========================================================================
+// IIndexed
+
+Obj* ASeq::nth(int i) {
+    ISeq* s = this;
+    for (int j=0; s && j<i; ++j)
+        s = s->next();
+    if (i >= 0 && s)
+        return s->first();
+    return outOfBounds(i);
+}
+
+Obj* ASeq::nth(int i, Obj* notFound) {
+    ISeq* s = this;
+    for (int j=0; s && j<i; ++j)
+        s = s->next();
+    return i >= 0 && s ? s->first() : notFound;
+}
+
+// =========================================================================
+// ICollection
+
+int ASeq::count() {
+    int n = 0;
+    for (ISeq* s=this; s; s=s->next())
+        ++n;
+    return n;
+}
+
+bool ASeq::isEmpty() {
+    return false;
+}
+
+ICollection* ASeq::conj(Obj* x) {
+    return pList(cons(x));
+}
+
+Obj* ASeq::outOfBounds(int i) {
+    std::stringstream ss;
+    ss << typeName() << " index (" << i << ") out of bounds";
+    throw SxOutOfBoundsError(ss.str());
+}
+
+// =========================================================================
+// VectorSeq
+
+VectorSeq* VectorSeq::create(Vector* v, size_t i) {
+    return new VectorSeq(v, i, v->impl().leafFor(i));
+}
+
+VectorSeq::VectorSeq(Vector* v, size_t i, Obj** leaf)
+    : _v(v), _i(i), _leaf(leaf) {
+    _typeId = TID_VectorSeq;
+}
+
+ISeq* VectorSeq::next() {
+    size_t i = _i + 1;
+    if (i >= _v->impl().size())
+        return NIL;
+    // the next element is in the same leaf, unless it starts a new one
+    return new VectorSeq(_v, i, i & 31 ? _leaf : _v->impl().leafFor(i));
+}
+
+Obj* VectorSeq::nth(int i) {
+    if (i >= 0 && i < count())
+        return _v->impl()[_i + i];
+    return outOfBounds(i);
+}
+
+Obj* VectorSeq::nth(int i, Obj* notFound) {
+    if (i >= 0 && i < count())
+        return _v->impl()[_i + i];
+    return notFound;
+}
+
+int VectorSeq::count() {
+    return _v->impl().size() - _i;
+}
+
+// =========================================================================
+// StringSeq
+
+StringSeq* StringSeq::create(String* s, size_t i) {
+    return new StringSeq(s, i);
+}
+
+StringSeq::StringSeq(String* s, size_t i) : _s(s), _i(i) {
+    _typeId = TID_StringSeq;
+}
+
+Obj* StringSeq::first() {
+    return Character::fetch(_s->val()[_i]);
+}
+
+ISeq* StringSeq::next() {
+    if (_i + 1 < _s->val().size())
+        return new StringSeq(_s, _i + 1);
+    return NIL;
+}
+
+Obj* StringSeq::nth(int i) {
+    if (i >= 0 && i < count())
+        return Character::fetch(_s->val()[_i + i]);
+    return outOfBounds(i);
+}
+
+Obj* StringSeq::nth(int i, Obj* notFound) {
+    if (i >= 0 && i < count())
+        return Character::fetch(_s->val()[_i + i]);
+    return notFound;
+}
+
+int StringSeq::count() {
+    return _s->val().size() - _i;
+}
+
+// =========================================================================
+// HamtSeq
+
+HamtSeq* HamtSeq::create(const Hamt& m) {
+    return new HamtSeq(m.begin(), m.size(), false);
+}
+
+HamtSeq* HamtSeq::create(const HamtSet& s) {
+    return new HamtSeq(s.Hamt::begin(), s.size(), true);
+}
+
+HamtSeq::HamtSeq(const Hamt::iterator& itr, size_t left, bool keys)
+    : _itr(itr), _left(left), _keys(keys), _first(nullptr) {
+    _typeId = TID_HamtSeq;
+}
+
+Obj* HamtSeq::first() {
+    if (_keys)
+        return _itr.pair()[0];
+    if (!_first)
+        _first = MapEntry::create(_itr.pair()[0], _itr.pair()[1]);
+    return _first;
+}
+
+ISeq* HamtSeq::next() {
+    if (_left == 1)
+        return NIL;
+    Hamt::iterator itr = _itr;
+    return new HamtSeq(++itr, _left - 1, _keys);
+}
+
+int HamtSeq::count() {
+    return _left;
+}
@@ -0,0 +1,92 @@
+/*
+  aseq.hpp
+  S. Edward Dolan
+  Saturday, October 17 2026
+*/
+
+#ifndef ASEQ_HPP_INCLUDED
+#define ASEQ_HPP_INCLUDED
+
+/*
+  The base of the seqs that are views of a collection, made by its seq().
+  Each produces its elements on demand and next() makes a view one
+  element on, so (first coll) is O(1) however big coll is. A view is never
+  empty, seq() of an empty collection is nil.
+
+  The subclasses only need first() and next(), the rest are done here by
+  walking the view, or overridden where the collection does better.
+*/
+struct ASeq : ISeq, ISeqable, IIndexed, ICollection {
+    std::string toString();
+    size_t getHash();
+    bool isEqualTo(Obj*);
+    Obj* copy();
+    // ISeq
+    ISeq* rest();
+    ISeq* cons(Obj*);
+    // ISeqable
+    ISeq* seq();
+    // IIndexed
+    Obj* nth(int);
+    Obj* nth(int, Obj*);
+    // ICollection
+    int count();
+    bool isEmpty();
+    ICollection* conj(Obj*);
+protected:
+    ASeq() { _ifaces |= IF_ASeq; }
+    Obj* outOfBounds(int i);    // throws
+};
+DEF_XFACE_CASTER(ASeq)
+
+// A view of a Vector from index i on
+struct VectorSeq : ASeq {
+    static VectorSeq* create(Vector* v, size_t i=0);
+    Obj* first() { return _leaf[_i & 31]; }
+    ISeq* next();
+    Obj* nth(int);
+    Obj* nth(int, Obj*);
+    int count();
+protected:
+    Vector* _v;
+    size_t _i;
+    Obj** _leaf;                // that holds element _i, see VecTrie
+    VectorSeq(Vector* v, size_t i, Obj** leaf);
+};
+DEF_CASTER(VectorSeq)
+
+// A view of a String's characters from index i on
+struct StringSeq : ASeq {
+    static StringSeq* create(String* s, size_t i=0);
+    Obj* first();
+    ISeq* next();
+    Obj* nth(int);
+    Obj* nth(int, Obj*);
+    int count();
+protected:
+    String* _s;
+    size_t _i;
+    StringSeq(String* s, size_t i);
+};
+DEF_CASTER(StringSeq)
+
+/*
+  A view of a Hashmap's entries, or of a Hashset's keys, from a Hamt
+  iterator on. A map's MapEntry is made when first() is first called.
+*/
+struct HamtSeq : ASeq {
+    static HamtSeq* create(const Hamt& m);
+    static HamtSeq* create(const HamtSet& s);
+    Obj* first();
+    ISeq* next();
+    int count();
+protected:
+    Hamt::iterator _itr;
+    size_t _left;               // entries from _itr on
+    bool _keys;                 // of a set
+    Obj* _first;                // made by first()
+    HamtSeq(const Hamt::iterator& itr, size_t left, bool keys);
+};
+DEF_CASTER(HamtSeq)
+
+#endif // ASEQ_HPP_INCLUDED
@@ -23,7 +23,7 @@ Bool* Bool::create(bool val) {
 
 Bool::Bool(bool val)
     : _val(val), _hash(val ? 1387 : 1385) {
-    _typeName = "SxBool";
+    _typeId = TID_Bool;
 }
 
 std::string Bool::toString() {
@@ -22,11 +22,7 @@ CFn::CFn(const std::string& name, cfn_t cfn)
     : Fn(name),
       _cfn(cfn) /*,
       _lambda()*/ {
-    _typeName = "SxCFn";
-}
-
-std::string CFn::typeName() {
-    return _typeName;
+    _typeId = TID_CFn;
 }
 
 std::string CFn::toString() {
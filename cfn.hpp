@@ -14,7 +14,6 @@ struct CFn : Fn {
     static void initCFns();
     static CFn* create(const std::string& name, cfn_t cfn);
     //static CFn* create(const std::string& name, cfnlambda_t lambda);
-    std::string typeName();
     std::string toString();
     FnMethod* addMethod(int reqArgs);
     cfn_t cfn() { return _cfn; }
@@ -16,7 +16,13 @@ void Character::shutdown() {
     _cache.clear();
 }
 
-Character* Character::fetch(int c) {
+Obj* Character::fetch(int c) {
+    return makeImmChar(c);
+}
+
+Character* Character::box(int c) {
+    if (c < 0 || c >= static_cast<int>(_cache.size()))
+        return new (PointerFreeGC) Character(c);
     if (_cache[c])
         return _cache[c];
     return _cache[c] = new (PointerFreeGC) Character(c);
@@ -29,7 +35,7 @@ int Character::val() {
 Character::Character(int c)
     : _val(c),
       _hash(std::hash<char>()(c)) {
-    _typeName = "SxCharacter";
+    _typeId = TID_Character;
 }
 
 std::string Character::toString() {
@@ -65,7 +71,7 @@ size_t Character::getHash() {
 bool Character::isEqualTo(Obj* obj) {
     if (this == obj)
         return true;
-    if (Character* c = dynamic_cast<Character*>(obj))
+    if (Character* c = pCharacter(obj))
         return _val == c->_val;
     return false;
 }
@@ -10,7 +10,8 @@
 struct Character : ISortable {
     static void init();
     static void shutdown();
-    static Character* fetch(int);
+    static Obj* fetch(int);      // always an immediate
+    static Character* box(int);
     int val();
     // 
     std::string toString();
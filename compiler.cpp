@@ -51,13 +51,17 @@ struct FnIR : gc {
     Fn* fn;
     FnMethod* method;          // current method emitted to
     hashmap_t globals;         // track vars that have yet to be DEF'd
+    hashmap_t links;           // direct linked vars, see linkVar()
     vecobj_t freeVars;
+    int tryDepth;              // TRYs being emitted, see emitCall()
     FnIR* parent;
     FnIR(Fn* fn, FnIR* parent)
         : fn(fn),
           method(nullptr),
           globals(),
+          links(),
           freeVars(),
+          tryDepth(0),
           parent(parent) {}
 };
 
@@ -65,22 +69,32 @@ struct LocalVar : Obj {
     LocalVar(Symbol* sym, int index, FnMethod* method)
         : sym(sym),
           index(index),
-          method(method) {}
+          method(method),
+          isMutable(rt::toBool(rt::get(sym->meta(), rt::KW_MUTABLE))) {
+        _typeId = TID_LocalVar;
+    }
     std::string toString() {
         return rt::toString(sym);
     }
     Symbol* sym;
     int index;
     FnMethod* method;
+    bool isMutable;             // assigned after it's bound, see ir.cpp
 };
 DEF_CASTER(LocalVar)
 
 struct FreeVar : Obj {
-    FreeVar(int index, bool indexIsLocal)
+    FreeVar(int index, bool indexIsLocal, bool isBoxed, int slot)
         : index(index),
-          indexIsLocal(indexIsLocal) {}
-    int index;
+          indexIsLocal(indexIsLocal),
+          isBoxed(isBoxed),
+          slot(slot) {
+        _typeId = TID_FreeVar;
+    }
+    int index;                  // parent's local, or parent's FreeVar
     bool indexIsLocal;
+    bool isBoxed;               // an Upval, else a copied value
+    int slot;                   // in the Closure's upvals or vals
 };
 DEF_CASTER(FreeVar)
 
@@ -102,17 +116,27 @@ static Fn* popFn() {
     if ((thisFn = thisFn->parent)) {
         emitConstant(fn);
         if (size_t n = freeVars.size()) {
-            fn->nUpvals(n);
+            int nUpvals = 0;
             emitByte(vasm::NEW_CLOSURE);
             emitByte(n);
             for (size_t i=0; i<n; ++i) {
                 FreeVar* fv = pFreeVar(freeVars[i]);
-                emitByte(fv->indexIsLocal ? 1 : 0);
-                emitByte(fv->index);
+                nUpvals += fv->isBoxed;
+                emitByte((fv->indexIsLocal ? vasm::CAPTURE_LOCAL : 0) |
+                         (fv->isBoxed ? vasm::CAPTURE_BOXED : 0));
+                emitByte(fv->indexIsLocal
+                         ? fv->index
+                         : pFreeVar(thisFn->freeVars[fv->index])->slot);
             }
+            fn->nUpvals(nUpvals);
+            fn->nVals(n - nUpvals);
         }
         // TODO: meta
     }
+#ifndef SXP_NO_PEEPHOLE
+    fn->peephole();
+#endif
+    fn->verify();
     // fn->dump();
     return fn;
 }
@@ -122,21 +146,24 @@ static Fn* popFn() {
 
 #define MAX_FREE_VARS 256
 
-static int registerFreeVar(FnIR* fnir, int index, bool indexIsLocal) {
+static int registerFreeVar(FnIR* fnir, int index, bool indexIsLocal,
+                           bool isBoxed) {
     size_t nFreeVars = fnir->freeVars.size();
+    int slot = 0;
+    for (size_t i=0; i<nFreeVars; ++i) {
+        FreeVar* f = pFreeVar(fnir->freeVars[i]);
+        if (f->index == index && f->indexIsLocal == indexIsLocal)
+            return i;
+        slot += f->isBoxed == isBoxed;
+    }
     if (nFreeVars == MAX_FREE_VARS) {
         std::stringstream ss;
         ss << "maximum free variables per fn (" << MAX_FREE_VARS
            << ") exceeded";
         throw SxCompilerError(ss.str());
     }
-    for (size_t i=0; i<nFreeVars; ++i) {
-        FreeVar* f = pFreeVar(fnir->freeVars[i]);
-        if (f->index == index && f->indexIsLocal == indexIsLocal)
-            return i;
-        ++i;
-    }
-    fnir->freeVars.push_back(new (PointerFreeGC) FreeVar(index, indexIsLocal));
+    fnir->freeVars.push_back(new (PointerFreeGC) FreeVar(index, indexIsLocal,
+                                                         isBoxed, slot));
     return fnir->freeVars.size() - 1;
 }
 
@@ -144,41 +171,43 @@ static int closeOver(LocalVar* loc, FnIR* fnir) {
     assert(fnir);
     assert(fnir->parent);
     if (fnir->parent->method == loc->method)
-        return registerFreeVar(fnir, loc->index, true);
-    return registerFreeVar(fnir, closeOver(loc, fnir->parent), false);
+        return registerFreeVar(fnir, loc->index, true, loc->isMutable);
+    return registerFreeVar(fnir, closeOver(loc, fnir->parent), false,
+                           loc->isMutable);
 }
 
+// i is an index into thisFn->freeVars
 static void emitStoreFreeIdx(int i) {
-    if (i < 5)
-        emitByte(vasm::STORE_FREE_0 + i);
-    else if (i < UINT8_MAX) {
+    FreeVar* fv = pFreeVar(thisFn->freeVars[i]);
+    if (fv->isBoxed) {
+        emitByte(vasm::STORE_UPVAL_B);
+        emitByte(fv->slot);
+    }
+    else if (fv->slot < 5)
+        emitByte(vasm::STORE_FREE_0 + fv->slot);
+    else {
         emitByte(vasm::STORE_FREE_B);
-        emitByte(i);
+        emitByte(fv->slot);
     }
-    else
-        // TODO: should this be a runtime error or does registerFreeVar handle?
-        assert(0 && "MAX_FREE_VARS exceeded");
 }
 
+// ditto
 static void emitLoadFreeIdx(int i) {
-    if (i < 5) {
-        emitByte(vasm::LOAD_FREE_0 + i);
-        if (rt::toBool(VAR_ONCE->get())) { // #^{:once true} fn ...
-            emitByte(vasm::LOAD_NIL);
-            emitStoreFreeIdx(i);
-        }
+    FreeVar* fv = pFreeVar(thisFn->freeVars[i]);
+    if (fv->isBoxed) {
+        emitByte(vasm::LOAD_UPVAL_B);
+        emitByte(fv->slot);
     }
-    else if (i < UINT8_MAX) {
+    else if (fv->slot < 5)
+        emitByte(vasm::LOAD_FREE_0 + fv->slot);
+    else {
         emitByte(vasm::LOAD_FREE_B);
-        emitByte(i);
-        if (rt::toBool(VAR_ONCE->get())) { // same
-            emitByte(vasm::LOAD_NIL);
-            emitStoreFreeIdx(i);
-        }
+        emitByte(fv->slot);
+    }
+    if (rt::toBool(VAR_ONCE->get())) { // #^{:once true} fn ...
+        emitByte(vasm::LOAD_NIL);
+        emitStoreFreeIdx(i);
     }
-    else
-        // TODO: should this be a runtime error or does register free handle?
-        assert(0 && "MAX_FREE_VARS exceeded");
 }
 
 // =========================================================================
@@ -290,7 +319,7 @@ static Obj* resolveIn(Namespace* ns, Symbol* sym, bool allowPrivate) {
     throw SxCompilerError("unresolved symbol: " + sym->toString());
 }
 
-static Obj* resolve(Symbol* sym) {
+Obj* resolve(Symbol* sym) {
     return resolveIn(rt::currentNS(), sym, false);
 }
 
@@ -533,6 +562,17 @@ static int registerVar(Var* var) {
     return index;
 }
 
+// the index of the cpool slot holding var's root, see Var::link()
+static int linkVar(Var* var) {
+    auto itr = thisFn->links.find(var);
+    if (itr != thisFn->links.end())
+        return pInteger(itr->second)->val();
+    int index = thisFn->fn->appendLinkedConstant(var->get());
+    var->link(thisFn->fn, index);
+    thisFn->links[var] = Integer::fetch(index);
+    return index;
+}
+
 static Var* lookupVar(Symbol* sym, bool intern) {
     Var* var = NIL;
     if (sym->hasNS()) {
@@ -592,6 +632,11 @@ static void emitSymbol(Symbol* sym, Ctx ctx) {
             ss << "can't take the value of a macro: " << rt::toString(var);
             throw SxCompilerError(ss.str());
         }
+        if (thisFn->parent && var->isLinkable()) {
+            // direct linked, but not from a run-once top level thunk
+            emitLoadConstantIdx(linkVar(var));
+            return;
+        }
         emitLoadConstantIdx(registerVar(var));
         emitByte(vasm::VAR_GET);
         return;
@@ -614,31 +659,134 @@ static void emitQUOTE(Obj* form, Ctx ctx) {
         throw SxCompilerError("QUOTE wants 1 arg");
 }
 
-static void emitCALL(int nArgs) {
+/*
+  Every CALL_N is followed by the index of its inline cache, see CallCache.
+  A TAIL_CALL_N replaces the caller's frame instead of pushing a new one.
+*/
+static void emitCALL(int nArgs, bool isTail = false) {
     if (nArgs < 5)
-        emitByte(vasm::CALL_0 + nArgs);
+        emitByte((isTail ? vasm::TAIL_CALL_0 : vasm::CALL_0) + nArgs);
     else if (nArgs <= UINT8_MAX) {
-        emitByte(vasm::CALL_B);
+        emitByte(isTail ? vasm::TAIL_CALL_B : vasm::CALL_B);
         emitByte(nArgs);
     }
     else {
-        emitByte(vasm::CALL_S);
+        emitByte(isTail ? vasm::TAIL_CALL_S : vasm::CALL_S);
         emitByte((uint8_t)nArgs);
         emitByte((uint8_t)(nArgs >> 8));
     }
+    uint16_t site = thisFn->method->newCallSite();
+    emitByte((uint8_t)site);
+    emitByte((uint8_t)(site >> 8));
+}
+
+/*
+  A call to one of these sxp procs with nArgs args compiles to op instead,
+  see emitInlineProc().
+*/
+struct InlineProc {
+    const char* name;
+    size_t nArgs;
+    vasm::Opcode op;
+};
+
+static const InlineProc INLINE_PROCS[] = {
+    {"+", 2, vasm::ADD}, {"-", 2, vasm::SUB},
+    {"*", 2, vasm::MUL}, {"/", 2, vasm::DIV},
+    {"==", 2, vasm::EQEQ}, {"<", 2, vasm::LT}, {"=", 2, vasm::EQ},
+    {"inc", 1, vasm::INC}, {"dec", 1, vasm::DEC},
+    {"nth", 2, vasm::NTH}
+};
+
+/*
+  (+ x y) => x y ADD, and so on for the INLINE_PROCS. Only when the head is
+  not a local, resolves to the sxp var, the var is not dynamic, and its root
+  is still the original proc. (+ x 1) and (- x 1) become INC and DEC. Code
+  compiled while *inline-procs* is false keeps the ordinary calls, so it
+  sees a later redefinition. Return false if form is not such a call.
+*/
+static bool emitInlineProc(Obj* form, Ctx ctx) {
+    Symbol* sym = pSymbol(rt::first(form));
+    if (!sym || !rt::inlineProcs())
+        return false;
+    int index;
+    bool isFree;
+    if (!sym->hasNS() && resolveLocalVar(sym, index, isFree))
+        return false;
+    Var* var = pVar(resolve(sym));
+    if (!var || var->ns() != rt::sxpNS() || var->isDynamic())
+        return false;
+    Proc* proc = pProc(var->get());
+    if (!proc)
+        return false;
+    size_t nArgs = rt::count(rt::next(form));
+    const InlineProc* ip = nullptr;
+    for (const InlineProc& x : INLINE_PROCS)
+        if (x.nArgs == nArgs && proc->name() == x.name
+            && var->sym()->name() == x.name)
+            ip = &x;
+    if (!ip)
+        return false;
+    vasm::Opcode op = ip->op;
+    Obj* y = rt::first(rt::next(rt::next(form)));
+    if ((op == vasm::ADD || op == vasm::SUB) && isFixnum(y)
+        && fixnumVal(y) == 1) {
+        op = op == vasm::ADD ? vasm::INC : vasm::DEC;
+        --nArgs;
+    }
+    for (form=rt::next(form); nArgs--; form=rt::next(form))
+        emit(rt::first(form), ctx == DEFAULT ? ctx : EXPRESSION);
+    emitByte(op);
+    return true;
+}
+
+/*
+  (name ...) inside (fn name ...), where name is still this fn's locals[0]
+  and the fn already has a fixed arity method for the args. Emit it as
+  SELF_CALL m, m's index in the constant pool, so the call doesn't have to
+  find the method. Return false if form is not such a call.
+*/
+static bool emitSelfCall(Obj* form, Ctx ctx) {
+    Symbol* sym = pSymbol(rt::first(form));
+    int index;
+    bool isFree;
+    if (!sym || sym->hasNS() || !resolveLocalVar(sym, index, isFree)
+        || isFree || index != 0)
+        return false;
+    size_t nArgs = rt::count(rt::next(form));
+    FnMethod* m = thisFn->fn->getMethod(nArgs);
+    if (!m || m->isRest())
+        return false;
+    emitLoadLocalIdx(0);
+    for (form=rt::next(form); form!=NIL; form=rt::next(form))
+        emit(rt::first(form), ctx == DEFAULT ? ctx : EXPRESSION);
+    int i = registerConstant(m);
+    emitByte(ctx == TAIL && !thisFn->tryDepth
+             ? vasm::TAIL_SELF_CALL : vasm::SELF_CALL);
+    emitByte((uint8_t)i);
+    emitByte((uint8_t)(i >> 8));
+    return true;
 }
 
-// (callable ...)
+/*
+  (callable ...)
+
+  A call in TAIL position is a tail call unless it's inside a TRY in this
+  fn, where the frame must stay put so its handlers (and the FINALLY code
+  after the call) still run.
+*/
 static void emitCall(Obj* form, Ctx ctx) {
+    if (emitInlineProc(form, ctx) || emitSelfCall(form, ctx))
+        return;
     emit(rt::first(form), EXPRESSION); // push the callable onto the stack
     size_t nArgs = 0;
     for (form=rt::next(form); form!=NIL; form=rt::next(form)) {
         // and the args
-        emit(rt::first(form), ctx);
+        emit(rt::first(form), ctx == DEFAULT ? ctx : EXPRESSION);
         ++nArgs;
     }
     // and the CALL_N instruction
-    emitCALL(nArgs);
+    emitCALL(nArgs, ctx == TAIL && !thisFn->tryDepth);
 }
 
 // (if ...)
@@ -991,14 +1139,15 @@ static void checkTry(Obj* s, Vector* tryExprs, Vector* catches,
 // original working emitter
 static void emitTRY(Obj* form, Ctx ctx) {
     // (TRY tryExprs catch* finally?)
-    Vector* tryExprs = Vector::create();
-    Vector* catches = Vector::create();
+    Vector* tryExprs = Vector::create()->transient();
+    Vector* catches = Vector::create()->transient();
     Obj* finallyExpr = NIL;
     /*
       First, collect all the expressions in the TRY form doing a bit of error
       handling.
     */
     checkTry(form, tryExprs, catches, &finallyExpr);
+    ++thisFn->tryDepth;
     /*
       The TRY expressions, CATCH forms, and FINALLY form should now be in the
       correct order, Sort it all out...
@@ -1058,7 +1207,7 @@ static void emitTRY(Obj* form, Ctx ctx) {
         }
         else {
             Obj* c = NIL;
-            anys = Vector::create();
+            anys = Vector::create()->transient();
             for (int i=0; i<catches->count(); ++i) {
                 // for each catch...
                 pushLocalEnv();  // this CATCH form scope
@@ -1119,6 +1268,7 @@ static void emitTRY(Obj* form, Ctx ctx) {
             thisFn->method->addHandler(s, e, finallyAddr,
                                        new (PointerFreeGC) SxAny());
         }
+    --thisFn->tryDepth;
 }
 
 // (set! sym val)
@@ -1188,25 +1338,39 @@ Obj* macroExpand1(Obj* form, bool initalize) {
         if (!var)
             return form;        // ...no
         // ...yes
-        pushFn(rt::genName("MACRO_EXPANDER_THUNK__", "__AUTO__"));
-        thisFn->method = thisFn->fn->addMethod(false, 0);
-        thisFn->method->nextLocalIdx();
-        emitConstant(var->get());
-        int nArgs = 0;
-        for (ISeq* s=rt::next(form); s!=NIL; s=rt::next(s), ++nArgs)
-            emitConstant(rt::first(s));
-        emitCALL(nArgs);
-        emitByte(vasm::RETURN);
-        Fn* fn = thisFn->fn;
-        // fn->dump();
-        VM vm;
-        Obj* x = vm.run(fn);
-        thisFn = thisFn->parent;
+        vecobj_t args;
+        for (ISeq* s=rt::next(form); s!=NIL; s=rt::next(s))
+            args.push_back(rt::first(s));
+        Obj* x = callNow(var->get(), args);
+        // a macro that returns its rest arg returns an ArgSeq, or one that
+        // returns (seq coll) an ASeq, not a form
+        if (ArgSeq* a = pArgSeq(x))
+            return a->copy();
+        if (ASeq* a = pASeq(x))
+            return a->copy();
         return x;
     }
     return form;
 }
 
+Obj* callNow(Obj* f, const vecobj_t& args) {
+    FnIR* outer = thisFn;
+    pushFn(rt::genName("COMPILE_TIME_THUNK__", "__AUTO__"));
+    thisFn->method = thisFn->fn->addMethod(false, 0);
+    thisFn->method->nextLocalIdx();
+    emitConstant(f);
+    for (auto arg : args)
+        emitConstant(arg);
+    emitCALL(args.size());
+    emitByte(vasm::RETURN);
+    Fn* fn = thisFn->fn;
+    fn->verify();
+    // fn->dump();
+    thisFn = outer;
+    PooledVM vm;
+    return vm->run(fn);
+}
+
 static Obj* macroExpand(Obj* form) {
     Obj* x = macroExpand1(form);
     if (x != form)
@@ -1334,10 +1498,16 @@ static void init() {
     recurTarget = nullptr;
 }
 
+Obj* lower(Obj* form, bool initialize) {
+    if (initialize)
+        init();
+    return ir::lower(form);
+}
+
 Fn* compile(Obj* form) {
     init();
     Fn* f = emitFN(List::create(rt::genSym("COMPILER_THUNK__", "__AUTO__"),
-                                Vector::create(), form),
+                                Vector::create(), ir::lower(form)),
                    DEFAULT);
     // f->dump();
     return f;
@@ -12,6 +12,9 @@ namespace compiler {
 Fn* compile(Obj*);
 Symbol* resolveSymbol(Symbol*);
 Obj* macroExpand1(Obj* form, bool initialize=false);
+Obj* lower(Obj* form, bool initialize=false);
+Obj* callNow(Obj* fn, const vecobj_t& args);
+Obj* resolve(Symbol*);
 
 }
 
@@ -12,11 +12,13 @@ struct SxCastError;
 struct SxError : Obj, std::runtime_error {
     SxError()
         : std::runtime_error("an unknown error occurred") {
-        _typeName = "SxError";
+        _typeId = TID_SxError;
+        _ifaces |= IF_SxError;
     }
     SxError(const std::string& msg)
         : std::runtime_error(msg) {
-        _typeName = "SxError";
+        _typeId = TID_SxError;
+        _ifaces |= IF_SxError;
     }
     virtual ~SxError() throw() {}
     virtual SxError* clone(std::string msg) {
@@ -25,7 +27,7 @@ struct SxError : Obj, std::runtime_error {
     std::string toString() {
         size_t maxMsgLen = 30;
         std::stringstream ss;
-        ss << "#<" << _typeName << " \"";
+        ss << "#<" << typeName() << " \"";
         std::string w(what());
         size_t n = w.size();
         if (n > maxMsgLen)
@@ -38,14 +40,16 @@ struct SxError : Obj, std::runtime_error {
 };
 
 struct SxCastError : SxError {
-    SxCastError() : SxError() { _typeName = "SxCastError"; }
+    SxCastError() : SxError() {
+        _typeId = TID_SxCastError;
+    }
     SxCastError(const std::string& msg)
         : SxError(msg) {
-        _typeName = "SxCastError";
+        _typeId = TID_SxCastError;
     }
     SxCastError(const std::string& fromName, const std::string& toName)
         : SxError("cannot cast: " + fromName + " -> " + toName) {
-        _typeName = "SxCastError";
+        _typeId = TID_SxCastError;
     }
     SxCastError* clone(std::string msg) {
         return new (PointerFreeGC) SxCastError(msg);
@@ -53,10 +57,12 @@ struct SxCastError : SxError {
 };
 DEF_CASTER(SxCastError)
 
-DEF_CASTER(SxError)             // NOTE: must be after SxCastError
+DEF_XFACE_CASTER(SxError)            // NOTE: must be after SxCastError
 
 struct SxAny: SxError {
-    SxAny() : SxError() {_typeName = "SxAny";}
+    SxAny() : SxError() {
+        _typeId = TID_SxAny;
+    }
     SxAny* clone() {
         return new (PointerFreeGC) SxAny();
     }
@@ -64,10 +70,12 @@ struct SxAny: SxError {
 DEF_CASTER(SxAny)
 
 struct SxIOError : SxError {
-    SxIOError() : SxError() {_typeName = "SxIOError";}
+    SxIOError() : SxError() {
+        _typeId = TID_SxIOError;
+    }
     SxIOError(const std::string& msg)
         : SxError(msg) {
-        _typeName = "SxIOError";
+        _typeId = TID_SxIOError;
     }
     SxIOError* clone(std::string msg) {
         return new (PointerFreeGC) SxIOError(msg);
@@ -76,10 +84,12 @@ struct SxIOError : SxError {
 DEF_CASTER(SxIOError)
 
 struct SxReaderError : SxError {
-    SxReaderError() : SxError() {_typeName = "SxReaderError";}
+    SxReaderError() : SxError() {
+        _typeId = TID_SxReaderError;
+    }
     SxReaderError(const std::string& msg)
         : SxError(msg) {
-        _typeName = "SxReaderError";
+        _typeId = TID_SxReaderError;
     }
     SxReaderError* clone(std::string msg) {
         return new (PointerFreeGC) SxReaderError(msg);
@@ -90,11 +100,11 @@ DEF_CASTER(SxReaderError)
 struct SxRuntimeError : SxError {
     SxRuntimeError()
         : SxError() {
-        _typeName = "SxRuntimeError";
+        _typeId = TID_SxRuntimeError;
     }
     SxRuntimeError(const std::string& msg)
         : SxError(msg){
-        _typeName = "SxRuntimeError";
+        _typeId = TID_SxRuntimeError;
     }
     SxRuntimeError* clone(std::string msg) {
         return new (PointerFreeGC) SxRuntimeError(msg);
@@ -103,10 +113,12 @@ struct SxRuntimeError : SxError {
 DEF_CASTER(SxRuntimeError)
 
 struct SxCompilerError : SxError {
-    SxCompilerError() : SxError() { _typeName = "SxCompilerError"; }
+    SxCompilerError() : SxError() {
+        _typeId = TID_SxCompilerError;
+    }
     SxCompilerError(const std::string& msg)
         : SxError(msg) {
-        _typeName = "SxCompilerError";
+        _typeId = TID_SxCompilerError;
     }
     SxCompilerError* clone(std::string msg) {
         return new (PointerFreeGC) SxCompilerError(msg);
@@ -115,10 +127,12 @@ struct SxCompilerError : SxError {
 DEF_CASTER(SxCompilerError)
 
 struct SxSyntaxError : SxError {
-    SxSyntaxError() : SxError() { _typeName = "SxSyntaxError"; }
+    SxSyntaxError() : SxError() {
+        _typeId = TID_SxSyntaxError;
+    }
     SxSyntaxError(const std::string& msg)
         : SxError(msg) {
-        _typeName = "SxSyntaxError";
+        _typeId = TID_SxSyntaxError;
     }
     SxSyntaxError* clone(std::string msg) {
         return new (PointerFreeGC) SxSyntaxError(msg);
@@ -127,10 +141,12 @@ struct SxSyntaxError : SxError {
 DEF_CASTER(SxSyntaxError)
 
 struct SxArithmeticError : SxError {
-    SxArithmeticError() : SxError() { _typeName = "SxArithmeticError"; }
+    SxArithmeticError() : SxError() {
+        _typeId = TID_SxArithmeticError;
+    }
     SxArithmeticError(const std::string& msg)
         : SxError(msg) {
-        _typeName = "SxArithmeticError";
+        _typeId = TID_SxArithmeticError;
     }
     SxArithmeticError* clone(std::string msg) {
         return new (PointerFreeGC) SxArithmeticError(msg);
@@ -139,10 +155,12 @@ struct SxArithmeticError : SxError {
 DEF_CASTER(SxArithmeticError)
 
 struct SxOutOfBoundsError : SxError {
-    SxOutOfBoundsError() : SxError() { _typeName = "SxOutOfBoundsError"; }
+    SxOutOfBoundsError() : SxError() {
+        _typeId = TID_SxOutOfBoundsError;
+    }
     SxOutOfBoundsError(const std::string& msg)
         : SxError(msg) {
-        _typeName = "SxOutOfBoundsError";
+        _typeId = TID_SxOutOfBoundsError;
     }
     SxOutOfBoundsError* clone(std::string msg) {
         return new (PointerFreeGC) SxOutOfBoundsError(msg);
@@ -152,11 +170,11 @@ DEF_CASTER(SxOutOfBoundsError)
 
 struct SxNotImplementedError : SxError {
     SxNotImplementedError() : SxError() {
-        _typeName = "SxNotImplementedError";
+        _typeId = TID_SxNotImplementedError;
     }
     SxNotImplementedError(const std::string& msg)
         : SxError(msg) {
-        _typeName = "SxNotImplementedError";
+        _typeId = TID_SxNotImplementedError;
     }
     SxNotImplementedError* clone(std::string msg) {
         return new (PointerFreeGC) SxNotImplementedError(msg);
@@ -167,11 +185,11 @@ DEF_CASTER(SxNotImplementedError)
 struct SxIllegalArgumentError : SxError {
     SxIllegalArgumentError()
         : SxError() {
-        _typeName = "SxIllegalArgumentError";
+        _typeId = TID_SxIllegalArgumentError;
     }
     SxIllegalArgumentError(const std::string& msg)
         : SxError(msg) {
-        _typeName = "SxIllegalArgumentError";
+        _typeId = TID_SxIllegalArgumentError;
     }
     SxIllegalArgumentError* clone(std::string msg) {
         return new (PointerFreeGC) SxIllegalArgumentError(msg);
@@ -180,14 +198,16 @@ struct SxIllegalArgumentError : SxError {
 DEF_CASTER(SxIllegalArgumentError)
 
 struct SxSortError : SxError {
-    SxSortError() : SxError() { _typeName = "SxSortError"; }
+    SxSortError() : SxError() {
+        _typeId = TID_SxSortError;
+    }
     SxSortError(const std::string& msg)
         : SxError(msg) {
-        _typeName = "SxSortError";
+        _typeId = TID_SxSortError;
     }
     SxSortError(const std::string& t1, const std::string& t2)
         : SxError(t1 + " and " + t2 + " cannot be lexicographically sorted") {
-        _typeName = "SxSortError";
+        _typeId = TID_SxSortError;
     }
     SxSortError* clone(std::string msg) {
         return new (PointerFreeGC) SxSortError(msg);
@@ -197,11 +217,11 @@ DEF_CASTER(SxSortError)
 
 struct SxRegexError : SxError {
     SxRegexError() : SxError() {
-        _typeName = "SxRegexError";
+        _typeId = TID_SxRegexError;
     }
     SxRegexError(const std::string& msg)
         : SxError(msg) {
-        _typeName = "SxRegexError";
+        _typeId = TID_SxRegexError;
     }
     SxRegexError* clone(std::string msg) {
         return new (PointerFreeGC) SxRegexError(msg);
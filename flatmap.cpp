@@ -0,0 +1,179 @@
+/*
+  flatmap.cpp
+  S. Edward Dolan
+  Saturday, October 17 2026
+*/
+
+#include "sxp.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+inline size_t hashOf(Obj* key) {
+    // spread the bits, an identity hash has its low bits clear
+    size_t h = rt::getHash(key) * 0x9e3779b97f4a7c15ull;
+    return h ^ (h >> 32);
+}
+
+inline uint8_t h2(size_t hash) {
+    return hash & 0x7f;
+}
+
+#ifdef __SSE2__
+
+// bit i is set if byte i of the group is c
+inline uint32_t match(const uint8_t* group, uint8_t c) {
+    __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(c)));
+}
+
+// bit i is set if byte i of the group is EMPTY or DELETED, the high bit
+inline uint32_t matchFree(const uint8_t* group) {
+    __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return _mm_movemask_epi8(g);
+}
+
+#else
+
+inline uint32_t match(const uint8_t* group, uint8_t c) {
+    uint32_t m = 0;
+    for (int i=0; i<16; ++i)
+        m |= uint32_t(group[i] == c) << i;
+    return m;
+}
+
+inline uint32_t matchFree(const uint8_t* group) {
+    uint32_t m = 0;
+    for (int i=0; i<16; ++i)
+        m |= uint32_t(group[i] >> 7) << i;
+    return m;
+}
+
+#endif
+
+} // namespace
+
+// =========================================================================
+
+FlatMap::FlatMap(const FlatMap& m) : FlatMap() {
+    *this = m;
+}
+
+FlatMap& FlatMap::operator=(const FlatMap& m) {
+    if (this == &m)
+        return *this;
+    clear();
+    if (m._cap) {
+        rehash(m._cap);
+        std::copy(m._hashes, m._hashes + _cap, _hashes);
+        std::copy(m._ctrl, m._ctrl + _cap, _ctrl);
+        std::copy(m._slots, m._slots + _cap, _slots);
+        _size = m._size;
+        _deleted = m._deleted;
+    }
+    return *this;
+}
+
+void FlatMap::clear() {
+    _ctrl = nullptr;
+    _hashes = nullptr;
+    _slots = nullptr;
+    _cap = _size = _deleted = 0;
+}
+
+// the index of key's slot, or _cap
+size_t FlatMap::findIndex(Obj* key, size_t hash) const {
+    if (!_cap)
+        return 0;
+    size_t mask = _cap / GROUP - 1, g = (hash >> 7) & mask;
+    for (size_t probe=1;; ++probe) {
+        const uint8_t* ctrl = _ctrl + g * GROUP;
+        for (uint32_t m=match(ctrl, h2(hash)); m; m&=m-1) {
+            size_t i = g * GROUP + __builtin_ctz(m);
+            // an identical key is found without touching its hash
+            Obj* k = _slots[i].first;
+            if (k == key || (_hashes[i] == hash && rt::isEqualTo(k, key)))
+                return i;
+        }
+        // a group with an EMPTY slot ends every probe that reaches it
+        if (match(ctrl, EMPTY))
+            return _cap;
+        g = (g + probe) & mask; // the triangular steps visit every group
+    }
+}
+
+FlatMap::iterator FlatMap::find(Obj* key) const {
+    return iterator(this, findIndex(key, hashOf(key)));
+}
+
+Obj*& FlatMap::operator[](Obj* key) {
+    size_t hash = hashOf(key);
+    size_t i = findIndex(key, hash);
+    if (i < _cap)
+        return _slots[i].second;
+    if ((_size + _deleted + 1) * 8 > _cap * 7) {
+        // grow, or just drop the DELETED slots if half of it is free
+        size_t cap = _cap ? _cap : GROUP;
+        rehash((_size + 1) * 2 > cap ? cap * 2 : cap);
+    }
+    size_t mask = _cap / GROUP - 1, g = (hash >> 7) & mask;
+    uint32_t m;
+    for (size_t probe=1; !(m = matchFree(_ctrl + g * GROUP)); ++probe)
+        g = (g + probe) & mask;
+    i = g * GROUP + __builtin_ctz(m);
+    if (_ctrl[i] == DELETED)
+        --_deleted;
+    _ctrl[i] = h2(hash);
+    _hashes[i] = hash;
+    _slots[i] = value_type(key, NIL);
+    ++_size;
+    return _slots[i].second;
+}
+
+size_t FlatMap::erase(Obj* key) {
+    size_t i = findIndex(key, hashOf(key));
+    if (i == _cap)
+        return 0;
+    // no probe has gone past a group with an EMPTY slot, it was never full
+    if (match(_ctrl + i / GROUP * GROUP, EMPTY))
+        _ctrl[i] = EMPTY;
+    else {
+        _ctrl[i] = DELETED;
+        ++_deleted;
+    }
+    _slots[i] = value_type(NIL, NIL); // let the GC have them
+    --_size;
+    return 1;
+}
+
+// move the entries to new arrays of cap slots, by their cached hashes
+void FlatMap::rehash(size_t cap) {
+    uint8_t* ctrl = _ctrl;
+    size_t* hashes = _hashes;
+    value_type* slots = _slots;
+    size_t oldCap = _cap;
+    // the hashes and control bytes hold no pointers, the GC needn't scan them
+    _hashes = gc_allocator<size_t>().allocate(cap + cap / sizeof(size_t));
+    _ctrl = reinterpret_cast<uint8_t*>(_hashes + cap);
+    std::fill(_ctrl, _ctrl + cap, EMPTY);
+    _slots = gc_allocator<value_type>().allocate(cap);
+    std::fill(_slots, _slots + cap, value_type(NIL, NIL));
+    _cap = cap;
+    _deleted = 0;
+    size_t mask = cap / GROUP - 1;
+    for (size_t j=0; j<oldCap; ++j) {
+        if (!isFull(ctrl[j]))
+            continue;
+        size_t hash = hashes[j], g = (hash >> 7) & mask;
+        uint32_t m;
+        for (size_t probe=1; !(m = matchFree(_ctrl + g * GROUP)); ++probe)
+            g = (g + probe) & mask;
+        size_t i = g * GROUP + __builtin_ctz(m);
+        _ctrl[i] = h2(hash);
+        _hashes[i] = hash;
+        _slots[i] = slots[j];
+    }
+}
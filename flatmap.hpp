@@ -0,0 +1,85 @@
+/*
+  flatmap.hpp
+  S. Edward Dolan
+  Saturday, October 17 2026
+*/
+
+#ifndef FLATMAP_HPP_INCLUDED
+#define FLATMAP_HPP_INCLUDED
+
+/*
+  An open addressing hash table of Obj* keys, in the style of a Swiss
+  table. The slots are split into groups of 16, each slot has a control
+  byte that is EMPTY, DELETED, or the low 7 bits of its key's hash. A probe
+  compares a whole group's control bytes with those 7 bits at once (with
+  SSE2, where available), and only calls rt::isEqualTo() for a slot whose
+  cached full hash matches too.
+
+  The key/val pairs live in one contiguous array the GC scans, the control
+  bytes and hashes in another it doesn't. Iteration walks the array.
+
+  Not persistent, it's for the runtime's internal tables (see hashmap_t).
+  Hashmap and Hashset are Hamts, they need to share structure.
+*/
+struct FlatMap {
+    typedef std::pair<Obj*, Obj*> value_type;
+    FlatMap() : _ctrl(nullptr), _hashes(nullptr), _slots(nullptr),
+                _cap(0), _size(0), _deleted(0) {}
+    FlatMap(const FlatMap&);
+    FlatMap& operator=(const FlatMap&);
+    size_t size() const { return _size; }
+    bool empty() const { return !_size; }
+    void clear();
+    struct iterator {
+        iterator(const FlatMap* m, size_t i) : _m(m), _i(i) { skip(); }
+        value_type& operator*() const { return _m->_slots[_i]; }
+        value_type* operator->() const { return _m->_slots + _i; }
+        iterator& operator++() { ++_i; skip(); return *this; }
+        bool operator==(const iterator& x) const { return _i == x._i; }
+        bool operator!=(const iterator& x) const { return _i != x._i; }
+    protected:
+        const FlatMap* _m;
+        size_t _i;
+        void skip() { while (_i < _m->_cap && !isFull(_m->_ctrl[_i])) ++_i; }
+    };
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, _cap); }
+    iterator find(Obj* key) const;
+    size_t count(Obj* key) const { return find(key) != end(); }
+    // the val of key, a new nil one if key wasn't in the map
+    Obj*& operator[](Obj* key);
+    size_t erase(Obj* key);
+protected:
+    static constexpr size_t GROUP = 16;
+    static constexpr uint8_t EMPTY = 0x80;
+    static constexpr uint8_t DELETED = 0xfe;
+    static bool isFull(uint8_t c) { return c < 0x80; }
+    uint8_t* _ctrl;             // _cap control bytes
+    size_t* _hashes;            // _cap hashes, of the full slots
+    value_type* _slots;
+    size_t _cap;                // 0, or a power of 2 >= GROUP
+    size_t _size;
+    size_t _deleted;            // DELETED control bytes
+    size_t findIndex(Obj* key, size_t hash) const;
+    void rehash(size_t cap);
+};
+
+// A FlatMap of keys, each mapped to itself
+struct FlatSet : FlatMap {
+    struct iterator : FlatMap::iterator {
+        iterator(const FlatMap::iterator& i) : FlatMap::iterator(i) {}
+        Obj* operator*() const { return FlatMap::iterator::operator*().first; }
+        iterator& operator++() {
+            FlatMap::iterator::operator++();
+            return *this;
+        }
+    };
+    iterator begin() const { return FlatMap::begin(); }
+    iterator end() const { return FlatMap::end(); }
+    void insert(Obj* x) { (*this)[x] = x; }
+};
+
+typedef FlatMap hashmap_t;
+typedef FlatSet hashset_t;
+
+#endif // FLATMAP_HPP_INCLUDED
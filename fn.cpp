@@ -14,6 +14,7 @@ std::string ThrowHandler::toString() {
        << _endAddr << ' '
        << "hsa=" << std::setw(4) << std::hex << std::setfill('0')
        << _handlerAddr << ' '
+       << "depth=" << std::dec << _depth << ' '
        << _e->typeName();
     return ss.str();
 }
@@ -22,9 +23,11 @@ FnMethod::FnMethod() : _bytecode(),
                        _isRest(false),
                        _reqArgs(0),
                        _nLocals(0),
+                       _maxStack(1),
                        _fn(nullptr),
-                       _handlers() {
-    _typeName = "SxFnMethod";
+                       _handlers(),
+                       _callCaches() {
+    _typeId = TID_FnMethod;
 }
 
 FnMethod::FnMethod(bool isRest, int reqArgs, Fn* fn)
@@ -32,9 +35,11 @@ FnMethod::FnMethod(bool isRest, int reqArgs, Fn* fn)
       _isRest(isRest),
       _reqArgs(reqArgs),
       _nLocals(0),
+      _maxStack(1),             // a CALL_PROC or CALL_CFN result
       _fn(fn),
-      _handlers() {
-    _typeName = "SxFnMethod";
+      _handlers(),
+      _callCaches() {
+    _typeId = TID_FnMethod;
 }
 
 void FnMethod::rewrite(size_t addr) {
@@ -44,12 +49,20 @@ void FnMethod::rewrite(size_t addr) {
     _bytecode[addr + 1] = i >> 8;
 }
 
+uint16_t FnMethod::newCallSite() {
+    if (_callCaches.size() > UINT16_MAX)
+        throw SxCompilerError("too many call sites in one FN method");
+    _callCaches.push_back({nullptr, nullptr});
+    return _callCaches.size() - 1;
+}
+
 void FnMethod::dump(std::ostream& s) const {
     s << "----------------------------------------------------------------"
         "FnMethod-------\n"
       << "    rest: " << (_isRest ? "true" : "false") << '\n'
       << " reqArgs: " << _reqArgs << '\n'
       << " nLocals: " << std::dec << _nLocals << '\n'
+      << "maxStack: " << _maxStack << '\n'
       << "      bc: ";
     size_t i = 0;
     while (i != _bytecode.size()) {
@@ -68,7 +81,8 @@ void FnMethod::dump(std::ostream& s) const {
         "--------------" << std::endl;
 }
 
-int FnMethod::getHandlerAddr(uint16_t pc, const SxError& err) const {
+const ThrowHandler* FnMethod::getHandler(uint16_t pc,
+                                         const SxError& err) const {
     // std::cout << _fn->name() << ": getHandlerAddr: pc:" << pc << " n:"
     //           << _handlers.size() << std::endl;
     for (auto h : _handlers) {
@@ -76,23 +90,53 @@ int FnMethod::getHandlerAddr(uint16_t pc, const SxError& err) const {
         //           << " ename:" << err.typeName()
         //           << " hsa: " << h->_startAddr << " hea:" << h->_endAddr
         //           << std::endl;
-        if ((err.typeName() == h->_e->typeName()
-             || h->_e->typeName() == "SxError"
-             || h->_e->typeName() == "SxAny")
+        if ((err.typeId() == h->_e->typeId()
+             || h->_e->typeId() == TID_SxError
+             || h->_e->typeId() == TID_SxAny)
             && pc >= h->_startAddr
             && pc <= h->_endAddr) {
             // puts("YES!");
-            return h->_handlerAddr;
+            return h;
         }
     }
     // puts("NO!");
-    return -1;                  // not found
+    return nullptr;             // not found
 }
 
 void FnMethod::addHandler(int psa, int pea, int hsa, SxError* e) {
     _handlers.push_back(ThrowHandler::create(psa, pea, hsa, e));
 }
 
+// append every address the handlers refer to
+void FnMethod::handlerAddrs(std::vector<int>& addrs) const {
+    for (auto h : _handlers) {
+        addrs.push_back(h->_startAddr);
+        addrs.push_back(h->_endAddr);
+        addrs.push_back(h->_handlerAddr);
+    }
+}
+
+// set each handler's depth, in the order handlerAddrs() listed them
+void FnMethod::handlerDepths(const std::vector<int>& depths) {
+    for (size_t i=0; i<_handlers.size(); ++i)
+        _handlers[i]->_depth = depths[i];
+}
+
+/*
+  Replace the bytecode with code, which was rewritten from it. newAddr maps
+  each instruction address in the old code (and the address one past its
+  end) to the address in code, and moves the handlers.
+*/
+void FnMethod::replaceCode(const vecu8_t& code,
+                           const std::vector<int>& newAddr) {
+    _bytecode = code;
+    for (auto h : _handlers) {
+        h->_startAddr = newAddr[h->_startAddr];
+        h->_endAddr = newAddr[h->_endAddr];
+        h->_handlerAddr = newAddr[h->_handlerAddr];
+    }
+}
+
 
 // =========================================================================
 // Fn
@@ -107,13 +151,16 @@ Fn::Fn(const std::string& name)
       _cpool(),
       _restMethod(nullptr),
       _methods(),
-      _nUpvals(0) {
-    _typeName = "SxFn";
+      _flatMethods(),
+      _nUpvals(0),
+      _nVals(0) {
+    _typeId = TID_Fn;
+    _ifaces |= IF_Fn;
 }
 
 std::string Fn::toString() {
     std::stringstream ss;
-    ss << "#<" << _typeName << ' ' << _name << ' ' << this << '>';
+    ss << "#<" << typeName() << ' ' << _name << ' ' << this << '>';
     return ss.str();
 }
 
@@ -122,9 +169,15 @@ size_t Fn::getHash() {
 }
 
 FnMethod* Fn::getMethod(int nArgs) {
-    auto itr = _methods.find(nArgs);
-    if (itr != _methods.end())
-        return itr->second;     // fixed arity method
+    if (nArgs < N_FLAT_METHODS) {
+        if (_flatMethods[nArgs])
+            return _flatMethods[nArgs]; // fixed arity method
+    }
+    else {
+        auto itr = _methods.find(nArgs);
+        if (itr != _methods.end())
+            return itr->second;         // ditto
+    }
     if (_restMethod && nArgs >= _restMethod->_reqArgs)
         return _restMethod;     // rest method
     return nullptr;             // not found
@@ -142,18 +195,34 @@ FnMethod* Fn::addMethod(bool isRest, int reqArgs) {
         ss << "ambiguous FN method with " << reqArgs << " parameters";
         throw SxCompilerError(ss.str());
     }
-    else
-        return _methods[reqArgs] = new FnMethod(false, reqArgs, this);
+    else {
+        FnMethod* m = _methods[reqArgs] = new FnMethod(false, reqArgs, this);
+        if (reqArgs < N_FLAT_METHODS)
+            _flatMethods[reqArgs] = m;
+        return m;
+    }
+}
+
+// use the methods of fn, which must all take fewer than N_FLAT_METHODS args
+void Fn::shareMethods(const Fn* fn) {
+    assert(fn->_methods.empty() || fn->_methods.rbegin()->first
+           < N_FLAT_METHODS);
+    std::copy(fn->_flatMethods, fn->_flatMethods + N_FLAT_METHODS,
+              _flatMethods);
+    _restMethod = fn->_restMethod;
 }
 
 int Fn::appendConstant(Obj* x) {
+    INumber* y = pINumber(x);
     for (size_t i=0; i<_cpool.size(); ++i) {
-        INumber* y = pINumber(x);
+        if (std::find(_linkedSlots.begin(), _linkedSlots.end(), (int)i)
+            != _linkedSlots.end())
+            continue;           // may change under us
         if (y) {
             // Compare numbers by value so 3.3, 3/4, and 1024 will each have
-            // exactly one slot in the fn's constant pool. Some smaller
-            // integers are cached, so they all can't be compared by pointer.
-            if (y->isEqualTo(_cpool[i]))
+            // exactly one slot in the fn's constant pool. Fixnums compare by
+            // word but floats, ratios and big integers can't.
+            if (rt::isEqualTo(x, _cpool[i]))
                 return i;
         }
         else
@@ -162,19 +231,47 @@ int Fn::appendConstant(Obj* x) {
             // and \space is \space. However, '(1 2 3) may appear multiple
             // times in the cpool because it is mutable:
             // (let [x '(1 2 3) y '(1 2 3)] (set-nth! 1 y :two))
-            if (y == x)
+            if (_cpool[i] == x)
                 return i;
     }
     _cpool.push_back(x);
     return _cpool.size() - 1;
 }
 
+/*
+  Append x in a slot of its own, never shared with another constant. The
+  slot is rewritten by Var::setRoot() when the var it was linked to is given
+  a new root.
+*/
+int Fn::appendLinkedConstant(Obj* x) {
+    _cpool.push_back(x);
+    _linkedSlots.push_back(_cpool.size() - 1);
+    return _cpool.size() - 1;
+}
+
+// run vasm::peephole() over every method
+void Fn::peephole() {
+    for (auto m : _methods)
+        vasm::peephole(m.second);
+    if (_restMethod)
+        vasm::peephole(_restMethod);
+}
+
+// run vasm::verify() over every method
+void Fn::verify() {
+    for (auto m : _methods)
+        vasm::verify(m.second);
+    if (_restMethod)
+        vasm::verify(_restMethod);
+}
+
 void Fn::dump(bool dumpMethods, std::ostream& s) const {
     s << "================================================================Fn=="
         "===========\n"
       << "    name: " << _name << '\n'
       << "    hash: " << _hash << '\n'
       << " nUpvals: " << _nUpvals << '\n'
+      << "   nVals: " << _nVals << '\n'
       << "      cp: ";
     for (size_t i=0; i<_cpool.size(); ++i) {
         if (i)
@@ -8,6 +8,7 @@
 #define FN_HPP_INCLUDED
 
 struct Fn;
+struct FnMethod;
 
 /*
   (try
@@ -32,6 +33,8 @@ struct ThrowHandler : Obj {
         return new ThrowHandler(psa, pea, hsa, e);        
     }
     std::string toString();
+    int handlerAddr() const { return _handlerAddr; }
+    int depth() const { return _depth; }
 protected:
     int _startAddr;             // protected code start address (inclusive)
     /*
@@ -43,15 +46,30 @@ protected:
     int _endAddr;
     int _handlerAddr;           // CATCH block start addr
     SxError* _e;                // instance of type of error handled
+    int _depth;                 // operand stack depth to unwind to
     ThrowHandler(int psa, int pea, int hsa, SxError* e)
         : _startAddr(psa),
           _endAddr(pea),
           _handlerAddr(hsa),
-          _e(e) {
-        _typeName = "SxThrowHandler";
+          _e(e),
+          _depth(0) {
+        _typeId = TID_ThrowHandler;
     }
 };
 
+/*
+  A monomorphic inline cache, one per CALL_N instruction. callee is the Fn
+  called last time from this site (the Fn of a Closure, so every closure of
+  one fn hits), and method is the FnMethod that was selected for the site's
+  fixed arg count. A different callee simply replaces the entry.
+*/
+struct CallCache {
+    Obj* callee;
+    FnMethod* method;
+};
+
+typedef std::vector<CallCache, gc_allocator<CallCache>> veccallcache_t;
+
 struct FnMethod : Obj {
     friend struct Fn;
     const vecu8_t& bc() const { return _bytecode; }
@@ -60,20 +78,29 @@ struct FnMethod : Obj {
     int nLocals() const { return _nLocals; }
     void nLocals(int n) { _nLocals = n; } // for Proc
     int nextLocalIdx() { return _nLocals++; }
+    int maxStack() const { return _maxStack; }
+    void maxStack(int n) { _maxStack = n; } // see vasm::verify()
     const Fn* fn() const { return _fn; }
     void appendByte(uint8_t byte) { _bytecode.push_back(byte); }
     void rewrite(size_t addr);  // why size_t?
     uint16_t nextAddress() { return static_cast<uint16_t>(_bytecode.size()); };
     void dump(std::ostream&) const;
-    int getHandlerAddr(uint16_t pc, const SxError& e) const;
+    const ThrowHandler* getHandler(uint16_t pc, const SxError& e) const;
     void addHandler(int psa, int pea, int hsa, SxError* e);
+    void handlerAddrs(std::vector<int>& addrs) const;
+    void handlerDepths(const std::vector<int>& depths);
+    void replaceCode(const vecu8_t& code, const std::vector<int>& newAddr);
+    uint16_t newCallSite();     // index of a new CallCache for a CALL_N
+    CallCache* callCaches() const { return _callCaches.data(); }
 protected:
     vecu8_t _bytecode;
     bool _isRest;               // true if method is a rest method
     int _reqArgs;               // minimum required arguments (may be 0)
     int _nLocals;               // number of required local slots on the stack
+    int _maxStack;              // operand slots needed above the locals
     struct Fn* _fn;             // parent function
     std::vector<ThrowHandler*, gc_allocator<ThrowHandler*>> _handlers;
+    mutable veccallcache_t _callCaches; // filled in by VM::doCall()
     FnMethod();
     FnMethod(bool isRest, int reqArgs, Fn* fn);
 };
@@ -93,20 +120,32 @@ struct Fn : virtual Obj {
     // 
     FnMethod* getMethod(int nArgs);
     FnMethod* addMethod(bool isRest, int reqArgs);
+    void shareMethods(const Fn* fn);
     int appendConstant(Obj* x);
+    int appendLinkedConstant(Obj* x);
+    void setConstant(int i, Obj* x) { _cpool[i] = x; }
     int nUpvals() { return _nUpvals; }
     void nUpvals(int n) { _nUpvals = n; }
+    int nVals() { return _nVals; }
+    void nVals(int n) { _nVals = n; }
     void dump(bool dumpMethods=true, std::ostream& = std::cout) const;
+    void peephole();
+    void verify();
 protected:
+    static constexpr int N_FLAT_METHODS = 8;
     size_t _hash;
     std::string _name;
     vecobj_t _cpool;            // constant pool
+    std::vector<int> _linkedSlots; // see appendLinkedConstant()
     FnMethod* _restMethod;      // may be nullptr
     methodmap_t _methods;       // map required arity (fixed) to FnMethod*
-    int _nUpvals;               // number of closed over vars
+    // _methods again, indexed by arity, for the arities below N_FLAT_METHODS
+    FnMethod* _flatMethods[N_FLAT_METHODS];
+    int _nUpvals;               // number of closed over mutable vars
+    int _nVals;                 // and immutable ones, copied by value
     Fn(const std::string& name);
 };
-DEF_CASTER(Fn)
+DEF_XFACE_CASTER(Fn)
 
 // =========================================================================
 
@@ -118,20 +157,26 @@ struct Upval : gc {
 protected:
     Upval(Obj** addr) : addr(addr), val(nullptr), next(nullptr) {}
 };
-DEF_CASTER(Upval)
 
 // =========================================================================
 
 typedef std::vector<Upval*, gc_allocator<Upval*>> vecupval_t;
 
+/*
+  A flat closure. A captured local that is never assigned after it is bound
+  is copied into vals when the closure is made. Only one that is, and must
+  stay shared with its frame and any other closure over it, is reached
+  through an Upval (see NEW_CLOSURE).
+*/
 struct Closure : Obj {
     static Closure* create(Fn* fn);
     Fn* fn;
+    vecobj_t vals;
     vecupval_t upvals;
     std::string toString();
 protected:
-    Closure(Fn* fn) : fn(fn), upvals(fn->nUpvals()) {
-        _typeName = "SxClosure";
+    Closure(Fn* fn) : fn(fn), vals(fn->nVals()), upvals(fn->nUpvals()) {
+        _typeId = TID_Closure;
     }
 };
 DEF_CASTER(Closure)
@@ -0,0 +1,388 @@
+/*
+  hamt.cpp
+  S. Edward Dolan
+  Saturday, October 17 2026
+*/
+
+#include "sxp.hpp"
+
+namespace {
+
+constexpr int BITS = 5;
+constexpr int MAX_SHIFT = 30;   // past it, a node is a collision node
+constexpr int FLAT = MAX_SHIFT + BITS; // the shift of a flat map's root
+constexpr uint32_t SLACK = 4;   // extra slots in a transient's new nodes
+
+inline uint32_t hashOf(Obj* key) {
+    size_t h = rt::getHash(key);
+    return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+inline bool keyEq(Obj* k1, Obj* k2) {
+    return k1 == k2 || rt::isEqualTo(k1, k2);
+}
+
+inline uint32_t bitpos(uint32_t hash, int shift) {
+    return 1u << ((hash >> shift) & 31);
+}
+
+inline int index(uint32_t map, uint32_t bit) {
+    return __builtin_popcount(map & (bit - 1));
+}
+
+inline bool isCollision(int shift) {
+    return shift > MAX_SHIFT;
+}
+
+inline int nEntries(const HamtNode* n, int shift) {
+    return isCollision(shift) ? n->datamap : __builtin_popcount(n->datamap);
+}
+
+inline int nNodes(const HamtNode* n) {
+    return __builtin_popcount(n->nodemap);
+}
+
+inline int nUsed(const HamtNode* n, int shift) {
+    return 2 * nEntries(n, shift) + nNodes(n);
+}
+
+HamtNode* newNode(uint32_t cap, const void* edit) {
+    if (edit)
+        cap += SLACK;
+    size_t words = sizeof(HamtNode) / sizeof(Obj*) + cap;
+    Obj** mem = gc_allocator<Obj*>().allocate(words);
+    std::fill(mem, mem + words, nullptr);
+    HamtNode* n = reinterpret_cast<HamtNode*>(mem);
+    n->datamap = n->nodemap = 0;
+    n->edit = edit;
+    n->cap = cap;
+    return n;
+}
+
+/*
+  Return n itself if it belongs to edit and has room for extra more slots
+  (which may be negative), else a copy of n that does.
+*/
+HamtNode* editable(HamtNode* n, int shift, int extra, const void* edit) {
+    int used = nUsed(n, shift);
+    if (edit && n->edit == edit && n->cap >= uint32_t(used + extra))
+        return n;
+    HamtNode* m = newNode(used + std::max(extra, 0), edit);
+    m->datamap = n->datamap;
+    m->nodemap = n->nodemap;
+    std::copy(n->data(), n->data() + 2 * nEntries(n, shift), m->data());
+    for (int j=0, nn=nNodes(n); j<nn; ++j)
+        m->child(j) = n->child(j);
+    return m;
+}
+
+// the changes below are made in place, to a node with room for them
+
+void putEntry(HamtNode* m, int shift, uint32_t bit, Obj* key, Obj* val) {
+    int i = isCollision(shift) ? m->datamap : index(m->datamap, bit);
+    Obj** d = m->data();
+    int end = 2 * nEntries(m, shift);
+    std::copy_backward(d + 2 * i, d + end, d + end + 2);
+    d[2 * i] = key;
+    d[2 * i + 1] = val;
+    if (isCollision(shift))
+        ++m->datamap;
+    else
+        m->datamap |= bit;
+}
+
+void eraseEntry(HamtNode* m, int shift, uint32_t bit, int i) {
+    Obj** d = m->data();
+    int end = 2 * nEntries(m, shift);
+    std::copy(d + 2 * i + 2, d + end, d + 2 * i);
+    d[end - 2] = d[end - 1] = nullptr;
+    if (isCollision(shift))
+        --m->datamap;
+    else
+        m->datamap &= ~bit;
+}
+
+void insertChild(HamtNode* m, uint32_t bit, HamtNode* child) {
+    int j = index(m->nodemap, bit);
+    for (int k=nNodes(m); k>j; --k)
+        m->child(k) = m->child(k - 1);
+    m->child(j) = child;
+    m->nodemap |= bit;
+}
+
+void removeChild(HamtNode* m, uint32_t bit) {
+    int nn = nNodes(m);
+    for (int k=index(m->nodemap, bit); k<nn-1; ++k)
+        m->child(k) = m->child(k + 1);
+    m->child(nn - 1) = nullptr;
+    m->nodemap &= ~bit;
+}
+
+// a node of two entries, or a path of nodes down to where they differ
+HamtNode* merge(Obj* k1, uint32_t h1, Obj* v1, Obj* k2, uint32_t h2,
+                Obj* v2, int shift, const void* edit) {
+    HamtNode* n;
+    if (isCollision(shift)) {
+        n = newNode(4, edit);
+        n->datamap = 2;
+    }
+    else {
+        uint32_t b1 = bitpos(h1, shift), b2 = bitpos(h2, shift);
+        if (b1 == b2) {
+            n = newNode(1, edit);
+            n->nodemap = b1;
+            n->child(0) = merge(k1, h1, v1, k2, h2, v2, shift + BITS, edit);
+            return n;
+        }
+        n = newNode(4, edit);
+        n->datamap = b1 | b2;
+        if (b2 < b1) {
+            std::swap(k1, k2);
+            std::swap(v1, v2);
+        }
+    }
+    Obj** d = n->data();
+    d[0] = k1;
+    d[1] = v1;
+    d[2] = k2;
+    d[3] = v2;
+    return n;
+}
+
+// search a flat map's root or a collision node
+Obj** findLinear(HamtNode* n, Obj* key) {
+    Obj** d = n->data();
+    for (uint32_t i=0; i<n->datamap; ++i)
+        if (d[2 * i] == key)
+            return d + 2 * i;
+    if (pKeyword(key))
+        return nullptr;         // keywords are interned, equal is identical
+    for (uint32_t i=0; i<n->datamap; ++i)
+        if (rt::isEqualTo(d[2 * i], key))
+            return d + 2 * i;
+    return nullptr;
+}
+
+Obj** find(HamtNode* n, uint32_t hash, int shift, Obj* key) {
+    for (;;) {
+        if (isCollision(shift))
+            return findLinear(n, key);
+        uint32_t bit = bitpos(hash, shift);
+        if (n->datamap & bit) {
+            Obj** pair = n->data() + 2 * index(n->datamap, bit);
+            return keyEq(pair[0], key) ? pair : nullptr;
+        }
+        if (!(n->nodemap & bit))
+            return nullptr;
+        n = n->child(index(n->nodemap, bit));
+        shift += BITS;
+    }
+}
+
+HamtNode* assoc(HamtNode* n, uint32_t hash, int shift, Obj* key, Obj* val,
+                const void* edit, bool& added) {
+    if (isCollision(shift)) {
+        Obj** d = n->data();
+        for (uint32_t i=0; i<n->datamap; ++i)
+            if (keyEq(d[2 * i], key)) {
+                if (d[2 * i + 1] == val)
+                    return n;
+                HamtNode* m = editable(n, shift, 0, edit);
+                m->data()[2 * i + 1] = val;
+                return m;
+            }
+        added = true;
+        HamtNode* m = editable(n, shift, 2, edit);
+        putEntry(m, shift, 0, key, val);
+        return m;
+    }
+    uint32_t bit = bitpos(hash, shift);
+    if (n->datamap & bit) {
+        int i = index(n->datamap, bit);
+        Obj** pair = n->data() + 2 * i;
+        if (keyEq(pair[0], key)) {
+            if (pair[1] == val)
+                return n;
+            HamtNode* m = editable(n, shift, 0, edit);
+            m->data()[2 * i + 1] = val;
+            return m;
+        }
+        // push the entry down into a subnode with the new one
+        added = true;
+        HamtNode* sub = merge(pair[0], hashOf(pair[0]), pair[1],
+                              key, hash, val, shift + BITS, edit);
+        HamtNode* m = editable(n, shift, -1, edit);
+        eraseEntry(m, shift, bit, i);
+        insertChild(m, bit, sub);
+        return m;
+    }
+    if (n->nodemap & bit) {
+        int j = index(n->nodemap, bit);
+        HamtNode* child = n->child(j);
+        HamtNode* sub = assoc(child, hash, shift + BITS, key, val, edit,
+                              added);
+        if (sub == child)
+            return n;
+        HamtNode* m = editable(n, shift, 0, edit);
+        m->child(j) = sub;
+        return m;
+    }
+    added = true;
+    HamtNode* m = editable(n, shift, 2, edit);
+    putEntry(m, shift, bit, key, val);
+    return m;
+}
+
+// true if n holds one entry and no subnodes, its parent takes the entry
+inline bool isSingleEntry(const HamtNode* n, int shift) {
+    return !n->nodemap && nEntries(n, shift) == 1;
+}
+
+HamtNode* dissoc(HamtNode* n, uint32_t hash, int shift, Obj* key,
+                 const void* edit, bool& removed) {
+    if (isCollision(shift)) {
+        Obj** d = n->data();
+        for (uint32_t i=0; i<n->datamap; ++i)
+            if (keyEq(d[2 * i], key)) {
+                removed = true;
+                HamtNode* m = editable(n, shift, 0, edit);
+                eraseEntry(m, shift, 0, i);
+                return m;
+            }
+        return n;
+    }
+    uint32_t bit = bitpos(hash, shift);
+    if (n->datamap & bit) {
+        int i = index(n->datamap, bit);
+        if (!keyEq(n->data()[2 * i], key))
+            return n;
+        removed = true;
+        HamtNode* m = editable(n, shift, 0, edit);
+        eraseEntry(m, shift, bit, i);
+        return m;
+    }
+    if (!(n->nodemap & bit))
+        return n;
+    HamtNode* child = n->child(index(n->nodemap, bit));
+    HamtNode* sub = dissoc(child, hash, shift + BITS, key, edit, removed);
+    if (sub == child)
+        return n;
+    HamtNode* m;
+    if (isSingleEntry(sub, shift + BITS)) {
+        // pull the subnode's last entry up into this node
+        Obj** pair = sub->data();
+        m = editable(n, shift, 1, edit);
+        removeChild(m, bit);
+        putEntry(m, shift, bit, pair[0], pair[1]);
+    }
+    else {
+        m = editable(n, shift, 0, edit);
+        m->child(index(m->nodemap, bit)) = sub;
+    }
+    return m;
+}
+
+} // namespace
+
+// =========================================================================
+
+Obj** Hamt::find(Obj* key) const {
+    if (!_root)
+        return nullptr;
+    if (_flat)
+        return ::find(_root, 0, FLAT, key);
+    return ::find(_root, hashOf(key), 0, key);
+}
+
+void Hamt::reserve(size_t n, const void* edit) {
+    if (_root || !n || n > MAX_FLAT)
+        return;
+    _root = newNode(2 * n, nullptr); // without a transient's slack
+    _root->edit = edit;
+}
+
+bool Hamt::assoc(Obj* key, Obj* val, const void* edit) {
+    if (!_root) {
+        _root = newNode(2, edit);
+        _root->datamap = 1;
+        _root->data()[0] = key;
+        _root->data()[1] = val;
+        _count = 1;
+        _flat = true;
+        return true;
+    }
+    bool added = false;
+    HamtNode* root;
+    if (_flat && (_count < MAX_FLAT || ::find(_root, 0, FLAT, key)))
+        root = ::assoc(_root, 0, FLAT, key, val, edit, added);
+    else {
+        if (_flat) {
+            // the new key makes it a trie
+            Obj** d = _root->data();
+            uint32_t hash = hashOf(d[0]);
+            root = newNode(2, edit);
+            root->datamap = bitpos(hash, 0);
+            root->data()[0] = d[0];
+            root->data()[1] = d[1];
+            for (size_t i=1; i<_count; ++i)
+                root = ::assoc(root, hashOf(d[2 * i]), 0, d[2 * i],
+                               d[2 * i + 1], edit, added);
+            _root = root;
+            _flat = false;
+            added = false;
+        }
+        root = ::assoc(_root, hashOf(key), 0, key, val, edit, added);
+    }
+    bool changed = root != _root || added; // a transient changes in place
+    _root = root;
+    _count += added;
+    return changed;
+}
+
+bool Hamt::dissoc(Obj* key, const void* edit) {
+    if (!_root)
+        return false;
+    bool removed = false;
+    HamtNode* root = _flat ? ::dissoc(_root, 0, FLAT, key, edit, removed)
+                           : ::dissoc(_root, hashOf(key), 0, key, edit,
+                                      removed);
+    if (!removed)
+        return false;
+    _root = --_count ? root : nullptr;
+    return true;
+}
+
+// =========================================================================
+// iterator
+
+Hamt::iterator::iterator(HamtNode* root, bool flat)
+    : _depth(-1), _shift(flat ? FLAT : 0), _cur(nullptr) {
+    if (root) {
+        _nodes[0] = root;
+        _pos[0] = 0;
+        _depth = 0;
+        advance();
+    }
+}
+
+// move to the next entry, depth first
+void Hamt::iterator::advance() {
+    while (_depth >= 0) {
+        HamtNode* n = _nodes[_depth];
+        int shift = _shift + _depth * BITS;
+        int nData = nEntries(n, shift);
+        int pos = _pos[_depth]++;
+        if (pos < nData) {
+            _cur = n->data() + 2 * pos;
+            return;
+        }
+        if (pos - nData < nNodes(n)) {
+            ++_depth;
+            _nodes[_depth] = n->child(pos - nData);
+            _pos[_depth] = 0;
+        }
+        else
+            --_depth;
+    }
+    _cur = nullptr;
+}
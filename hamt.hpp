@@ -0,0 +1,101 @@
+/*
+  hamt.hpp
+  S. Edward Dolan
+  Saturday, October 17 2026
+*/
+
+#ifndef HAMT_HPP_INCLUDED
+#define HAMT_HPP_INCLUDED
+
+/*
+  A node of a Hamt. Its slots follow it in the same allocation: the
+  key/value pairs of the entries held in the node from the front, and the
+  subnodes from the back, so either can grow into the free slots between
+  them.
+*/
+struct HamtNode {
+    uint32_t datamap;           // bits of the entries, or a collision count
+    uint32_t nodemap;           // bits of the subnodes
+    const void* edit;           // the transient that may change it in place
+    uint32_t cap;               // number of slots
+    Obj** data() { return reinterpret_cast<Obj**>(this + 1); }
+    HamtNode*& child(int j) {
+        return reinterpret_cast<HamtNode**>(this + 1)[cap - 1 - j];
+    }
+};
+
+/*
+  A persistent hash array mapped trie, the impl of Hashmap and Hashset.
+  Each level of the trie uses 5 bits of a key's hash to pick one of 32
+  positions in a node, which holds either the entry or a subnode. The
+  32-bit hash is used up after 7 levels, keys that still collide share a
+  collision node that is searched linearly.
+
+  A map of up to MAX_FLAT entries is flat, its root is a collision node
+  whose pairs are searched linearly without hashing the key. It becomes a
+  trie when the next key is added, and stays one.
+
+  The changes make new nodes along the key's path and share the rest with
+  the original. A non-null edit is a transient's owner token, nodes made
+  with it are changed in place by later changes with the same token, which
+  is how the VM builds a new map without a copy per entry.
+*/
+struct Hamt {
+    static constexpr size_t MAX_FLAT = 8;
+    Hamt() : _root(nullptr), _count(0), _flat(true) {}
+    size_t size() const { return _count; }
+    bool empty() const { return !_count; }
+    void clear() { _root = nullptr; _count = 0; _flat = true; }
+    // room for n entries in an empty map, which edit then adds in place
+    void reserve(size_t n, const void* edit);
+    // the key val pair of key, or nullptr
+    Obj** find(Obj* key) const;
+    // these return false if nothing changed, or if assoc() only replaced a
+    // value in place
+    bool assoc(Obj* key, Obj* val, const void* edit = nullptr);
+    bool dissoc(Obj* key, const void* edit = nullptr);
+    /*
+      Walks the entries in trie order. The map's order is its hash order,
+      which only depends on its keys.
+    */
+    struct iterator {
+        iterator() : _depth(-1), _cur(nullptr) {}
+        iterator(HamtNode* root, bool flat);
+        std::pair<Obj*, Obj*> operator*() const { return {_cur[0], _cur[1]}; }
+        Obj** pair() const { return _cur; }
+        iterator& operator++() { advance(); return *this; }
+        bool operator==(const iterator& x) const { return _cur == x._cur; }
+        bool operator!=(const iterator& x) const { return _cur != x._cur; }
+    protected:
+        static constexpr int MAX_DEPTH = 8; // 7 levels and the collisions
+        HamtNode* _nodes[MAX_DEPTH];
+        int _pos[MAX_DEPTH];    // next entry, then subnode, of each node
+        int _depth;
+        int _shift;             // of the root
+        Obj** _cur;
+        void advance();
+    };
+    iterator begin() const { return iterator(_root, _flat); }
+    iterator end() const { return iterator(); }
+protected:
+    HamtNode* _root;
+    size_t _count;
+    bool _flat;                 // see MAX_FLAT
+};
+
+// A Hamt of keys, each mapped to itself
+struct HamtSet : Hamt {
+    struct iterator : Hamt::iterator {
+        iterator() : Hamt::iterator() {}
+        iterator(HamtNode* root, bool flat) : Hamt::iterator(root, flat) {}
+        Obj* operator*() const { return _cur[0]; }
+        iterator& operator++() { advance(); return *this; }
+    };
+    iterator begin() const { return iterator(_root, _flat); }
+    iterator end() const { return iterator(); }
+    bool conj(Obj* x, const void* edit = nullptr) {
+        return assoc(x, x, edit);
+    }
+};
+
+#endif // HAMT_HPP_INCLUDED
@@ -18,16 +18,17 @@ Hashmap* Hashmap::create(const vecobj_t& v) {
     Hashmap* m = new Hashmap();
     if (v.size() == 0)
         return m;
+    m->_impl.reserve(v.size() / 2, m);
     for (auto itr=v.begin(); itr!=v.end(); ++itr) {
         Obj* key = *itr++, *val = *itr;
         if (m->hasKey(key))
             rt::warning("duplicate key in hashmap: " + rt::toString(key));
-        m->_impl[key] = val;
+        m->_impl.assoc(key, val, m); // m is its own transient
     }
     return m;
 }
 
-Hashmap* Hashmap::create(hashmap_t keysvals) {
+Hashmap* Hashmap::create(const Hamt& keysvals) {
     Hashmap* m = new Hashmap();
     m->_impl = keysvals;
     return m;
@@ -37,8 +38,8 @@ Hashmap* Hashmap::create(hashmap_t keysvals) {
 // Constructors
 
 Hashmap::Hashmap()
-    : Fn("SxHashmap"), _impl() {
-    _typeName = "SxHashmap";
+    : Fn("SxHashmap"), _impl(), _meta(nullptr), _edit(nullptr) {
+    _typeId = TID_Hashmap;
     createMethods();
 }
 
@@ -46,24 +47,57 @@ void Hashmap::clear() {
     _impl.clear();
 }
 
+/*
+  A transient copy of this map, it shares the Hamt until it changes. If this
+  map is empty, the copy has room for reserve entries.
+*/
+Hashmap* Hashmap::transient(size_t reserve) {
+    Hashmap* m = create(_impl);
+    m->_edit = m;
+    m->_impl.reserve(reserve, m);
+    return m;
+}
+
+// stop changing in place, this is then an ordinary map
+Hashmap* Hashmap::persistent() {
+    _edit = nullptr;
+    return this;
+}
+
+// a new map of impl, with this map's meta
+Hashmap* Hashmap::with(const Hamt& impl) {
+    Hashmap* m = new Hashmap();
+    m->_impl = impl;
+    m->_meta = _meta;
+    return m;
+}
+
+// Every map shares the methods of one Fn, a map costs no FnMethods
 void Hashmap::createMethods() {
+    static Fn* fn = nullptr;
+    if (fn) {
+        shareMethods(fn);
+        return;
+    }
+    fn = Fn::create("SxHashmap");
     // ({...} key)
-    FnMethod* m = addMethod(false, 1);
+    FnMethod* m = fn->addMethod(false, 1);
     m->nLocals(2);              // this, key
     m->appendByte(vasm::CALL_PROC);
     m->appendByte(static_cast<uint8_t>(vasm::GET_2));
     m->appendByte(static_cast<uint8_t>(vasm::GET_2 >> 8));
     m->appendByte(vasm::RETURN);
     // ({...} key not-found)
-    m = addMethod(false, 2);
+    m = fn->addMethod(false, 2);
     m->nLocals(3);              // this, key, not-found
     m->appendByte(vasm::CALL_PROC);
     m->appendByte(static_cast<uint8_t>(vasm::GET_3));
     m->appendByte(static_cast<uint8_t>(vasm::GET_3 >> 8));
     m->appendByte(vasm::RETURN);
+    shareMethods(fn);
 }
 
-const hashmap_t& Hashmap::impl() const {
+const Hamt& Hashmap::impl() const {
     return _impl;
 }
 
@@ -74,9 +108,9 @@ std::string Hashmap::toString() {
     std::stringstream ss;
     ss << "{";
     for (auto itr=_impl.begin(); itr!=_impl.end();) {
-        ss << rt::toString(itr->first)
+        ss << rt::toString((*itr).first)
            << ' '
-           << rt::toString(itr->second);
+           << rt::toString((*itr).second);
         if (++itr != _impl.end())
             ss << ", ";
     }
@@ -87,7 +121,7 @@ std::string Hashmap::toString() {
 /*
 size_t Hashmap::getHash() {
     std::stringstream ss;
-    ss << _typeName << " is not hashable";
+    ss << typeName() << " is not hashable";
     throw SxRuntimeError(ss.str());
 }
 */
@@ -97,12 +131,10 @@ bool Hashmap::isEqualTo(Obj* obj) {
         return true;
     if (Hashmap* p = pHashmap(obj)) {
         if (count() == p->count()) {
-            const auto& m2 = p->impl();
-            for (auto itr = _impl.begin(); itr!=_impl.end(); ++itr) {
-                auto itr2 = m2.find(itr->first);
-                if (itr2 != m2.end())
-                    if (!rt::isEqualTo(itr->second, itr2->second))
-                        return false;
+            for (auto e : _impl) {
+                Obj** pair = p->_impl.find(e.first);
+                if (!pair || !rt::isEqualTo(e.second, pair[1]))
+                    return false;
             }
             return true;
         }
@@ -120,13 +152,7 @@ Hashmap* Hashmap::copy() {
 ISeq* Hashmap::seq() {
     if (isEmpty())
         return NIL;
-    ISeq* ret = NIL, *tmp = NIL;
-    for (auto pair : _impl)
-        tmp = rt::cons(tmp, MapEntry::create(pair.first, pair.second));
-    // reverse it to match the order of the printed rep of this hashmap
-    for (; tmp; tmp=tmp->next())
-        ret = rt::cons(ret, tmp->first());
-    return ret;
+    return HamtSeq::create(_impl);  // in the order of the printed rep
 }
 
 // =========================================================================
@@ -141,12 +167,16 @@ bool Hashmap::isEmpty() {
 }
 
 ICollection* Hashmap::conj(Obj* obj) {
-    if (MapEntry* me = dynamic_cast<MapEntry*>(obj)) {
-        _impl[me->key()] = me->val();
-        return this;
+    if (MapEntry* me = pMapEntry(obj)) {
+        if (_edit) {
+            _impl.assoc(me->key(), me->val(), _edit);
+            return this;
+        }
+        Hamt impl = _impl;
+        return impl.assoc(me->key(), me->val()) ? with(impl) : this;
     }
     std::stringstream ss;
-    ss << "can't conj " << rt::typeName(obj) << " onto " << _typeName;
+    ss << "can't conj " << rt::typeName(obj) << " onto " << typeName();
     throw SxRuntimeError(ss.str());
 }
 
@@ -154,30 +184,35 @@ ICollection* Hashmap::conj(Obj* obj) {
 // 
 
 IAssociative* Hashmap::assoc(Obj* key, Obj* val) {
-    _impl[key] = val;
-    return this;
+    if (_edit) {
+        _impl.assoc(key, val, _edit);
+        return this;
+    }
+    Hamt impl = _impl;
+    return impl.assoc(key, val) ? with(impl) : this;
 }
 
 IAssociative* Hashmap::dissoc(Obj* key) {
-    _impl.erase(key);
-    return this;
+    if (_edit) {
+        _impl.dissoc(key, _edit);
+        return this;
+    }
+    Hamt impl = _impl;
+    return impl.dissoc(key) ? with(impl) : this;
 }
 
 bool Hashmap::hasKey(Obj* key) {
-    auto itr = _impl.find(key);
-    return itr != _impl.end();
+    return _impl.find(key);
 }
 
 MapEntry* Hashmap::entryAt(Obj* key) {
-    auto itr = _impl.find(key);
-    if (itr != _impl.end())
-        return MapEntry::create(itr->first, itr->second);
+    if (Obj** pair = _impl.find(key))
+        return MapEntry::create(pair[0], pair[1]);
     return NIL;
 }
 
 Obj* Hashmap::valAt(Obj* key, Obj* notFound) {
-    auto itr = _impl.find(key);
-    if (itr != _impl.end())
-        return itr->second;
+    if (Obj** pair = _impl.find(key))
+        return pair[1];
     return notFound;
 }
@@ -12,18 +12,30 @@
   ({:one 1 :two 2} :two)              => 2
   ({:one 1 :two 2} :three)            => nil
   ({:one 1 :two 2} :three :not-found) => :not-found
+
+  Persistent, assoc() dissoc() and conj() return a new map that shares
+  most of its Hamt with the original. A transient map changes in place
+  instead, for building a map without a new one per entry:
+
+    Hashmap* m = Hashmap::create()->transient();
+    ...
+    m->assoc(key, val);
+    ...
+    return m->persistent();
  */
 struct Hashmap : Fn, ISeqable, ICollection, IAssociative, IMeta {
     static Hashmap* create();
     static Hashmap* create(const vecobj_t& v);
-    static Hashmap* create(hashmap_t keysvals);
-    const hashmap_t& impl() const;
+    static Hashmap* create(const Hamt& keysvals);
+    const Hamt& impl() const;
     void clear();
+    Hashmap* transient(size_t reserve=0);
+    Hashmap* persistent();
     //
     std::string toString();
-    // TODO: a mutable hashmap really should not be hashable, but clojure's
-    // DESTRUCTURE depends on it being so. Obj::getHash() is used which hashes
-    // this pointer.
+    // TODO: clojure's DESTRUCTURE depends on a hashable hashmap. It's
+    // persistent now, but Obj::getHash() is still used, which hashes this
+    // pointer, as Lists and Vectors aren't hashable.
     // size_t getHash();
     bool isEqualTo(Obj*);
     Hashmap* copy();
@@ -43,10 +55,12 @@ struct Hashmap : Fn, ISeqable, ICollection, IAssociative, IMeta {
     Hashmap* meta() { return _meta; }
     Obj* withMeta(Hashmap* m) { _meta = m; return this; }
 protected:    
-    hashmap_t _impl;
+    Hamt _impl;
     Hashmap* _meta;
+    const void* _edit;          // the transient's owner token, or nullptr
     void createMethods();
     Hashmap();
+    Hashmap* with(const Hamt&);
 };
 DEF_CASTER(Hashmap)
 
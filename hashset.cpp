@@ -12,15 +12,38 @@ Hashset* Hashset::create() {
 
 Hashset* Hashset::create(vecobj_t objs) {
     Hashset* s = new Hashset();
+    s->_impl.reserve(objs.size(), s);
     for (auto e : objs)
-        s->_impl.insert(e);
+        s->_impl.conj(e, s);    // s is its own transient
     return s;
 }
 
-const hashset_t& Hashset::impl() const {
+const HamtSet& Hashset::impl() const {
     return _impl;
 }
 
+// a transient copy of this set, as Hashmap::transient()
+Hashset* Hashset::transient(size_t reserve) {
+    Hashset* s = copy();
+    s->_edit = s;
+    s->_impl.reserve(reserve, s);
+    return s;
+}
+
+// stop changing in place, this is then an ordinary set
+Hashset* Hashset::persistent() {
+    _edit = nullptr;
+    return this;
+}
+
+// a new set of impl, with this set's meta
+Hashset* Hashset::with(const HamtSet& impl) {
+    Hashset* s = new Hashset();
+    s->_impl = impl;
+    s->_meta = _meta;
+    return s;
+}
+
 std::string Hashset::toString() {
     std::stringstream ss;
     ss << "#{";
@@ -35,7 +58,7 @@ std::string Hashset::toString() {
 
 size_t Hashset::getHash() {
     std::stringstream ss;
-    ss << _typeName << " is not hashable";
+    ss << typeName() << " is not hashable";
     throw SxRuntimeError(ss.str());
 }
 
@@ -64,10 +87,7 @@ Hashset* Hashset::copy() {
 ISeq* Hashset::seq() {
     if (isEmpty())
         return NIL;
-    ISeq* s = List::create();
-    for (auto e : _impl)
-        s = s->cons(e);
-    return s;
+    return HamtSeq::create(_impl);
 }
 
 int Hashset::count() {
@@ -79,26 +99,33 @@ bool Hashset::isEmpty() {
 }
 
 ICollection* Hashset::conj(Obj* x) {
-    _impl.insert(x);
-    return this;
+    if (_edit) {
+        _impl.conj(x, _edit);
+        return this;
+    }
+    if (_impl.find(x))
+        return this;
+    HamtSet impl = _impl;
+    impl.conj(x);
+    return with(impl);
 }
 
 ISet* Hashset::disjoin(Obj* x) {
-    _impl.erase(x);
-    return this;
+    if (_edit) {
+        _impl.dissoc(x, _edit);
+        return this;
+    }
+    HamtSet impl = _impl;
+    return impl.dissoc(x) ? with(impl) : this;
 }
 
 bool Hashset::contains(Obj* x) {
-    for (auto e : _impl)
-        if (rt::isEqualTo(e, x))
-            return true;
-    return false;
+    return _impl.find(x);
 }
 
 Obj* Hashset::get(Obj* x, Obj* notFound) {
-    for (auto e : _impl)
-        if (rt::isEqualTo(e, x))
-            return e;
+    if (Obj** pair = _impl.find(x))
+        return pair[0];
     return notFound;
 }
 
@@ -111,26 +138,36 @@ Hashset* Hashset::withMeta(Hashmap* m) {
     return this;
 }
 
+// Every set shares the methods of one Fn, like Hashmap::createMethods()
 void Hashset::createMethods() {
+    static Fn* fn = nullptr;
+    if (fn) {
+        shareMethods(fn);
+        return;
+    }
+    fn = Fn::create("SxHashset");
     // (#{...} key)
-    FnMethod* m = addMethod(false, 1);
+    FnMethod* m = fn->addMethod(false, 1);
     m->nLocals(2);
     m->appendByte(vasm::CALL_PROC);
     m->appendByte(static_cast<uint8_t>(vasm::GET_2));
     m->appendByte(static_cast<uint8_t>(vasm::GET_2 >> 8));
     m->appendByte(vasm::RETURN);
     // (#{...} key not-found)
-    m = addMethod(false, 2);
+    m = fn->addMethod(false, 2);
     m->nLocals(3);
     m->appendByte(vasm::CALL_PROC);
     m->appendByte(static_cast<uint8_t>(vasm::GET_3));
     m->appendByte(static_cast<uint8_t>(vasm::GET_3 >> 8));
     m->appendByte(vasm::RETURN);
+    shareMethods(fn);
 }
 
 Hashset::Hashset()
     : Fn("SxHashset"),
-      _impl() {
-    _typeName = "SxHashset";
+      _impl(),
+      _meta(nullptr),
+      _edit(nullptr) {
+    _typeId = TID_Hashset;
     createMethods();
 }
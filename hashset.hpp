@@ -12,12 +12,16 @@
   (#{1 2 3} 3)            => 3
   (#{1 2 3} 4)            => nil
   (#{1 2 3} 4 :not-found) => :not-found
+
+  Persistent, and transient() like Hashmap.
  */
 struct Hashset : Fn,
                  ISeqable, ICollection, ISet, IMeta {
     static Hashset* create();
     static Hashset* create(vecobj_t);
-    const hashset_t& impl() const;
+    const HamtSet& impl() const;
+    Hashset* transient(size_t reserve=0);
+    Hashset* persistent();
     //
     std::string toString();
     size_t getHash();
@@ -37,10 +41,12 @@ struct Hashset : Fn,
     Hashmap* meta();
     Hashset* withMeta(Hashmap*);
 protected:
-    hashset_t _impl;
+    HamtSet _impl;
     Hashmap* _meta;
+    const void* _edit;          // the transient's owner token, or nullptr
     void createMethods();
     Hashset();
+    Hashset* with(const HamtSet&);
 };
 DEF_CASTER(Hashset)
 
@@ -6,88 +6,88 @@
 
 // ... x]
 // ...]
-case vasm::POP: {
+INSTR(POP) {
     ppop();
     break;
 }
 // ... x]
 // ... x x]
-case vasm::DUP: {
+INSTR(DUP) {
     ppush(ppeek());
     break;
 }
 // -------------------------------------------------------------------------
 // ...]
 // ... nil]
-case vasm::LOAD_NIL: {
+INSTR(LOAD_NIL) {
     ppush(NIL);
     break;
 }
 // ...]
 // ... true]
-case vasm::LOAD_TRUE: {
+INSTR(LOAD_TRUE) {
     ppush(rt::T);
     break;
 }
 // ...]
 // ... false]
-case vasm::LOAD_FALSE: {
+INSTR(LOAD_FALSE) {
     ppush(rt::F);
     break;
 }
 // -------------------------------------------------------------------------
 // ...]
 // ... ()]
-case vasm::LOAD_EMPTY_LIST: {
+INSTR(LOAD_EMPTY_LIST) {
     ppush(List::create());
     break;
 }
 // ...]
 // ... []]
-case vasm::LOAD_EMPTY_VECTOR: {
+INSTR(LOAD_EMPTY_VECTOR) {
     ppush(Vector::create());
     break;
 }
 // ...]
 // ... {}]
-case vasm::LOAD_EMPTY_HASHMAP: {
+INSTR(LOAD_EMPTY_HASHMAP) {
     ppush(Hashmap::create());
     break;
 }
 // ...]
 // ... #{}]
-case vasm::LOAD_EMPTY_HASHSET: {
+INSTR(LOAD_EMPTY_HASHSET) {
     ppush(Hashset::create());
     break;
 }
 // -------------------------------------------------------------------------
 // ... a1 a2 ... aN N]
 // ... [a1 a2 ... aN]]
-case vasm::NEW_VECTOR: {
-    int n = pInteger(ppop())->val();
-    vecobj_t v(n);
-    while (n--)
-        v[n] = ppop();
-    ppush(Vector::create(v));
+INSTR(NEW_VECTOR) {
+    int n = rt::toInt(ppop());
+    Vector* v = Vector::create()->transient();
+    for (Obj** p=sp-n; p<sp; ++p)
+        v->conj(*p);
+    sp -= n;
+    ppush(v->persistent());
     break;
 }
 // ... k1 v1 k2 v2 ... kN vN N]
 // ... {k1 v2 kN vN ... k2 v2}           unordered
-case vasm::NEW_HASHMAP: {
-    int n = pInteger(ppop())->val();
-    hashmap_t m;
-    while (n--) {
-        Obj* val = ppop();
-        m[ppop()] = val;
-    }
-    ppush(Hashmap::create(m));
+INSTR(NEW_HASHMAP) {
+    int n = rt::toInt(ppop());
+    Hashmap* m = Hashmap::create()->transient(n);
+    for (Obj** p=sp-2*n; p<sp; p+=2)
+        m->assoc(p[0], p[1]);
+    sp -= 2 * n;
+    ppush(m->persistent());
     break;
 }
 // TODO: Is this instruction needed? It's not emitted by the compiler.
 // ... a1 a2 ... aN N]
 // ... (a1 a2 ... aN)]
-case vasm::NEW_LIST: {
-    int n = pInteger(ppop())->val();
+INSTR(NEW_LIST) {
+    int n = rt::toInt(ppop());
     assert(n);                 // this instruction does not create empty lists
     ISeq* s = List::create(ppop());
     while (--n)
@@ -97,249 +97,281 @@ case vasm::NEW_LIST: {
 }
 // ... x y z N]
 // ... #{x y z}]
-case vasm::NEW_HASHSET: {
-    int n = pInteger(ppop())->val();
-    vecobj_t v(n);
-    while (n--)
-        v[n] = ppop();
-    ppush(Hashset::create(v));
+INSTR(NEW_HASHSET) {
+    int n = rt::toInt(ppop());
+    Hashset* s = Hashset::create()->transient(n);
+    for (Obj** p=sp-n; p<sp; ++p)
+        s->conj(*p);
+    sp -= n;
+    ppush(s->persistent());
     break;
 }
 // ...]
 // ...]                     unchanged
-case vasm::JUMP: {
-    pc = READ_U16();
+INSTR(JUMP) {
+    ip = curFrame->code + READ_U16();
     break;
 }
 // ... x]
 // ...]
-case vasm::JUMP_IF_FALSE: {
+INSTR(JUMP_IF_FALSE) {
     if (!rt::toBool(ppop()))
-        pc = READ_U16();
+        ip = curFrame->code + READ_U16();
     else
-        pc += 2;
+        ip += 2;
     break;
 }
 // -------------------------------------------------------------------------
 // ...]
 // ... x]
-case vasm::LOAD_CONST_0: {
+INSTR(LOAD_CONST_0) {
     ppush(curFrame->cp[0]);
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_CONST_1: {
+INSTR(LOAD_CONST_1) {
     ppush(curFrame->cp[1]);
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_CONST_2: {
+INSTR(LOAD_CONST_2) {
     ppush(curFrame->cp[2]);
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_CONST_3: {
+INSTR(LOAD_CONST_3) {
     ppush(curFrame->cp[3]);
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_CONST_4: {
+INSTR(LOAD_CONST_4) {
     ppush(curFrame->cp[4]);
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_CONST_B: {
-    ppush(curFrame->cp[curFrame->bc[pc++]]);
+INSTR(LOAD_CONST_B) {
+    ppush(curFrame->cp[*ip++]);
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_CONST_S: {
+INSTR(LOAD_CONST_S) {
     ppush(curFrame->cp[READ_U16()]);
-    pc += 2;
+    ip += 2;
     break;
 }
 // -------------------------------------------------------------------------
 // ...]
 // ... x]
-case vasm::LOAD_LOCAL_0: {
+INSTR(LOAD_LOCAL_0) {
     ppush(*curFrame->locals);
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_LOCAL_1: {
+INSTR(LOAD_LOCAL_1) {
     ppush(*(curFrame->locals + 1));
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_LOCAL_2: {
+INSTR(LOAD_LOCAL_2) {
     ppush(*(curFrame->locals + 2));
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_LOCAL_3: {
+INSTR(LOAD_LOCAL_3) {
     ppush(*(curFrame->locals + 3));
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_LOCAL_4: {
+INSTR(LOAD_LOCAL_4) {
     ppush(*(curFrame->locals + 4));
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_LOCAL_B: {
-    ppush(*(curFrame->locals + curFrame->bc[pc++]));
+INSTR(LOAD_LOCAL_B) {
+    ppush(*(curFrame->locals + *ip++));
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_LOCAL_S: {
+INSTR(LOAD_LOCAL_S) {
     ppush(*(curFrame->locals + READ_U16()));
-    pc += 2;
+    ip += 2;
     break;
 }
 // -------------------------------------------------------------------------
 // ... x]
 // ...]
-case vasm::STORE_LOCAL_0: {
+INSTR(STORE_LOCAL_0) {
     *(curFrame->locals) = ppop();
     break;
 }
 // ... x]
 // ...]
-case vasm::STORE_LOCAL_1: {
+INSTR(STORE_LOCAL_1) {
     *(curFrame->locals + 1) = ppop();
     break;
 }
 // ... x]
 // ...]
-case vasm::STORE_LOCAL_2: {
+INSTR(STORE_LOCAL_2) {
     *(curFrame->locals + 2) = ppop();
     break;
 }
 // ... x]
 // ...]
-case vasm::STORE_LOCAL_3: {
+INSTR(STORE_LOCAL_3) {
     *(curFrame->locals + 3) = ppop();
     break;
 }
 // ... x]
 // ...]
-case vasm::STORE_LOCAL_4: {
+INSTR(STORE_LOCAL_4) {
     *(curFrame->locals + 4) = ppop();
     break;
 }
 // ... x]
 // ...]
-case vasm::STORE_LOCAL_B: {
-    *(curFrame->locals + curFrame->bc[pc++]) = ppop();
+INSTR(STORE_LOCAL_B) {
+    *(curFrame->locals + *ip++) = ppop();
     break;
 }
 // ... x]
 // ...]
-case vasm::STORE_LOCAL_S: {
+INSTR(STORE_LOCAL_S) {
     *(curFrame->locals + READ_U16()) = ppop();
-    pc += 2;
+    ip += 2;
     break;
 }
 // -------------------------------------------------------------------------
 // ...]
 // ... x]
-case vasm::LOAD_FREE_0: {
-    ppush(*curFrame->closure->upvals[0]->addr);
+INSTR(LOAD_FREE_0) {
+    ppush(curFrame->closure->vals[0]);
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_FREE_1: {
-    ppush(*curFrame->closure->upvals[1]->addr);
+INSTR(LOAD_FREE_1) {
+    ppush(curFrame->closure->vals[1]);
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_FREE_2: {
-    ppush(*curFrame->closure->upvals[2]->addr);
+INSTR(LOAD_FREE_2) {
+    ppush(curFrame->closure->vals[2]);
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_FREE_3: {
-    ppush(*curFrame->closure->upvals[3]->addr);
+INSTR(LOAD_FREE_3) {
+    ppush(curFrame->closure->vals[3]);
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_FREE_4: {
-    ppush(*curFrame->closure->upvals[4]->addr);
+INSTR(LOAD_FREE_4) {
+    ppush(curFrame->closure->vals[4]);
     break;
 }
 // ...]
 // ... x]
-case vasm::LOAD_FREE_B: {
-    ppush(*curFrame->closure->upvals[curFrame->bc[pc++]]->addr);
+INSTR(LOAD_FREE_B) {
+    ppush(curFrame->closure->vals[*ip++]);
     break;
 }
 // -------------------------------------------------------------------------
 // ... x]
 // ...]
-case vasm::STORE_FREE_0: {
-    *(curFrame->closure->upvals[0]->addr) = ppop();
+INSTR(STORE_FREE_0) {
+    curFrame->closure->vals[0] = ppop();
+    break;
+}
+// ... x]
+// ...]
+INSTR(STORE_FREE_1) {
+    curFrame->closure->vals[1] = ppop();
     break;
 }
 // ... x]
 // ...]
-case vasm::STORE_FREE_1: {
-    *(curFrame->closure->upvals[1]->addr) = ppop();
+INSTR(STORE_FREE_2) {
+    curFrame->closure->vals[2] = ppop();
     break;
 }
 // ... x]
 // ...]
-case vasm::STORE_FREE_2: {
-    *(curFrame->closure->upvals[2]->addr) = ppop();
+INSTR(STORE_FREE_3) {
+    curFrame->closure->vals[3] = ppop();
     break;
 }
 // ... x]
 // ...]
-case vasm::STORE_FREE_3: {
-    *(curFrame->closure->upvals[3]->addr) = ppop();
+INSTR(STORE_FREE_4) {
+    curFrame->closure->vals[4] = ppop();
     break;
 }
 // ... x]
 // ...]
-case vasm::STORE_FREE_4: {
-    *(curFrame->closure->upvals[4]->addr) = ppop();
+INSTR(STORE_FREE_B) {
+    curFrame->closure->vals[*ip++] = ppop();
+    break;
+}
+// -------------------------------------------------------------------------
+// ...]
+// ... x]
+INSTR(LOAD_UPVAL_B) {
+    ppush(*curFrame->closure->upvals[*ip++]->addr);
     break;
 }
 // ... x]
 // ...]
-case vasm::STORE_FREE_B: {
-    *(curFrame->closure->upvals[curFrame->bc[pc++]]->addr) = ppop();
+INSTR(STORE_UPVAL_B) {
+    *(curFrame->closure->upvals[*ip++]->addr) = ppop();
     break;
 }
 // -------------------------------------------------------------------------
 // ... Fn]
 // ... Closure]
-case vasm::NEW_CLOSURE: {
+/*
+  NEW_CLOSURE n (flags index)*n
+
+  Each pair captures one free var of the new closure, in the order the
+  compiler numbered them. With CAPTURE_LOCAL set in flags, index is a
+  local of this frame, else it's a free var of this frame's closure. With
+  CAPTURE_BOXED set, the var is shared through an Upval, else its value is
+  copied into the next slot of the closure's vals.
+*/
+INSTR(NEW_CLOSURE) {
     Closure* c = Closure::create(cpFn(ppop()));
-    const vecu8_t& bc = curFrame->method->bc();
-    int n = bc[pc++]; // n closed-over vars
+    int n = *ip++; // n closed-over vars
+    int nVals = 0, nUpvals = 0;
     for (int i=0; i<n; ++i) {
-        uint8_t isLocal = bc[pc++];
-        uint8_t index = bc[pc++];
-        if (isLocal)
-            c->upvals[i] = captureUpval(index);
+        uint8_t flags = *ip++;
+        uint8_t index = *ip++;
+        if (flags & vasm::CAPTURE_BOXED)
+            c->upvals[nUpvals++] = flags & vasm::CAPTURE_LOCAL
+                ? captureUpval(index)
+                : curFrame->closure->upvals[index];
         else
-            c->upvals[i] = curFrame->closure->upvals[index];
+            c->vals[nVals++] = flags & vasm::CAPTURE_LOCAL
+                ? curFrame->locals[index]
+                : curFrame->closure->vals[index];
+    }
+    if (INSTRUMENTED && rt::vmStats) {
+        ++_stats.closures;
+        _stats.closureVals += nVals;
+        _stats.closureUpvals += nUpvals;
     }
     ppush(c);
     break;
@@ -347,120 +379,144 @@ case vasm::NEW_CLOSURE: {
 // -------------------------------------------------------------------------
 // ... var val]
 // ... var']
-case vasm::DEF: {
+INSTR(DEF) {
     Obj* val = ppop();
-    pVar(pstack.back())->setRoot(val, false); // <- don't reset macro flag
+    pVar(sp[-1])->setRoot(val, false); // <- don't reset macro flag
     break;
 }
 // ... var]
 // ... x]
-case vasm::VAR_GET: {
+INSTR(VAR_GET) {
     ppush(pVar(ppop())->get());
     break;
 }
 // -------------------------------------------------------------------------
 // ... callable]
 // ... callable]
-case vasm::CALL_0: {
-    doCall(ppeek(), 0);
+INSTR(CALL_0) {
+    DO_CALL_SITE(0, false);
     break;
 }
 // ... callable a1]
 // ... callable a1]
-case vasm::CALL_1: {
-    doCall(ppeek(1), 1);
+INSTR(CALL_1) {
+    DO_CALL_SITE(1, false);
     break;
 }
 // ... callable a1 a2]
 // ... callable a1 a2]
-case vasm::CALL_2: {
-    doCall(ppeek(2), 2);
+INSTR(CALL_2) {
+    DO_CALL_SITE(2, false);
     break;
 }
 // ... callable a1 a2 a3]
 // ... callable a1 a2 a3]
-case vasm::CALL_3: {
-    doCall(ppeek(3), 3);
+INSTR(CALL_3) {
+    DO_CALL_SITE(3, false);
     break;
 }
 // ... callable a1 a2 a3 a4]
 // ... callable a1 a2 a3 a4]
-case vasm::CALL_4: {
-    doCall(ppeek(4), 4);
+INSTR(CALL_4) {
+    DO_CALL_SITE(4, false);
     break;
 }
 
 // ... callable a1 a2 a3 a4 ... aFF]
 // ... callable a1 a2 a3 a4 ... aFF]
-case vasm::CALL_B: {
-    int nArgs = curFrame->bc[pc++];
-    doCall(ppeek(nArgs), nArgs);
+INSTR(CALL_B) {
+    int nArgs = *ip++;
+    DO_CALL_SITE(nArgs, false);
     break;
 }
 // ... callable a1 a2 a3 a4 ... aFFFF]
 // ... callable a1 a2 a3 a4 ... aFFFF]
-case vasm::CALL_S: {
+INSTR(CALL_S) {
     int nArgs = READ_U16();
-    pc += 2;
-    doCall(ppeek(nArgs), nArgs);
+    ip += 2;
+    DO_CALL_SITE(nArgs, false);
     break;
 }
 // ... proc arg*]
 // ... proc arg*]
-case vasm::CALL_PROC: {
+INSTR(CALL_PROC) {
     uint16_t id = READ_U16();
-    pc += 2;
+    ip += 2;
     GOTO(id);
     break;
 }
 // ... cfn arg*]
 // ... cfn arg* result]
-case vasm::CALL_CFN: {
-    CFn* cfn = cpCFn(pstack[curFrame->fnIndex]);
-    ppush(cfn->cfn()(&pstack[curFrame->fnIndex]));
+INSTR(CALL_CFN) {
+    CFn* cfn = cpCFn(*curFrame->locals);
+    ppush(cfn->cfn()(curFrame->locals));
     break;
 }
 // -------------------------------------------------------------------------
 // ... x]
 // ...]
-case vasm::RETURN: {
+INSTR(RETURN) {
     if (fpop())
-        return ppop();
+        return true;
+    LOAD_IP();
+    /*
+      (vm-trace) and (vm-stats) are procs, so a change of loop variant is
+      noticed here, on the return from the proc.
+    */
+    if (rt::vmInstrumented() != INSTRUMENTED)
+        return false;
     break;
 }
 // ... var map]
 // ... var]
-case vasm::SET_META: {
+INSTR(SET_META) {
     Obj* m = ppop();
     rt::withMeta(ppeek(), cpHashmap(m));
     break;
 }
 // ... callable a1 a2 ... aN-1 (e1 e2 ... eM) N]
 // ... callable a2 a2 ... aN e1 e2 ... eM]
-case vasm::APPLY: {
-    int nArgs = pInteger(ppop())->val() - 1;
-    for (ISeq* s=rt::seq(ppop()); s!=NIL; s=rt::next(s), ++nArgs)
-        ppush(rt::first(s));    // unpack the tail seq
-    doCall(cpFn(ppeek(nArgs)), nArgs);
+INSTR(APPLY) {
+    int nArgs = rt::toInt(ppop()) - 1;
+    Obj* tail = ppop();
+    /*
+      Unpack the tail, its length isn't known to vasm::verify(), leaving room
+      for doCall()'s nil rest arg. A Vector or an ArgSeq is copied straight
+      from its array, after reserve() as it may move an ArgSeq's args.
+    */
+    if (Vector* v = pVector(tail)) {
+        reserve(pdepth() + v->impl().size() + 1);
+        sp = std::copy(v->impl().begin(), v->impl().end(), sp);
+        nArgs += v->impl().size();
+    }
+    else if (ArgSeq* a = pArgSeq(tail)) {
+        reserve(pdepth() + a->count() + 1);
+        sp = std::copy(a->begin(), a->end(), sp);
+        nArgs += a->count();
+    }
+    else
+        for (ISeq* s=rt::seq(tail); s!=NIL; s=rt::next(s), ++nArgs) {
+            reserve(pdepth() + 2);
+            *sp++ = rt::first(s);
+        }
+    DO_CALL(cpFn(ppeek(nArgs)), nArgs, nullptr);
     break;
 }
 // ... x y]
 // ... y x]
-case vasm::SWAP: {
-    size_t i = pstack.size() - 2;
-    std::iter_swap(pstack.begin() + i, pstack.begin() + i + 1);
+INSTR(SWAP) {
+    std::iter_swap(sp - 2, sp - 1);
     break;
 }
 // ... x y z]
 // ... y x z]
-case vasm::SWAP2: {
-    size_t i = pstack.size() - 3;
-    std::iter_swap(pstack.begin() + i, pstack.begin() + i + 1);
+INSTR(SWAP2) {
+    std::iter_swap(sp - 3, sp - 2);
     break;
 }
 // ... SxError-or-string]
 // ...]
-case vasm::THROW: {
+INSTR(THROW) {
     Obj* obj = ppop();
     if (String* p = pString(obj))
         throw SxError(p->val());
@@ -476,27 +532,358 @@ case vasm::THROW: {
 }
 // ... SxError]
 // ...]
-case vasm::RETHROW: {
+INSTR(RETHROW) {
     throw *cpSxError(ppop());
     break;
 }
 // ... val var]
 // ... val]
-case vasm::VAR_SET: {
+INSTR(VAR_SET) {
     cpVar(ppop())->set(ppeek());
     break;
 }
 // ...]
 // ...]
-case vasm::JSR: {
+INSTR(JSR) {
     uint16_t addr = READ_U16();
-    jpush(pc + 2);    // resume address after the JSR instruction
-    pc = addr;
+    jpush(ip + 2 - curFrame->code); // resume address after the JSR instruction
+    ip = curFrame->code + addr;
     break;
 }
 // ...]
 // ...]
-case vasm::RET: {
-    pc = jpop();      // resume address after the JSR instruction
+INSTR(RET) {
+    ip = curFrame->code + jpop(); // resume address after the JSR instruction
+    break;
+}
+// -------------------------------------------------------------------------
+// The current frame is replaced by the called fn's frame, see dropFrame().
+// The stack effect is shown relative to the current frame's fn.
+
+// fn local* ... callable]
+// callable]
+INSTR(TAIL_CALL_0) {
+    DO_CALL_SITE(0, true);
+    break;
+}
+// fn local* ... callable a1]
+// callable a1]
+INSTR(TAIL_CALL_1) {
+    DO_CALL_SITE(1, true);
+    break;
+}
+// fn local* ... callable a1 a2]
+// callable a1 a2]
+INSTR(TAIL_CALL_2) {
+    DO_CALL_SITE(2, true);
+    break;
+}
+// fn local* ... callable a1 a2 a3]
+// callable a1 a2 a3]
+INSTR(TAIL_CALL_3) {
+    DO_CALL_SITE(3, true);
+    break;
+}
+// fn local* ... callable a1 a2 a3 a4]
+// callable a1 a2 a3 a4]
+INSTR(TAIL_CALL_4) {
+    DO_CALL_SITE(4, true);
+    break;
+}
+// fn local* ... callable a1 a2 a3 a4 ... aFF]
+// callable a1 a2 a3 a4 ... aFF]
+INSTR(TAIL_CALL_B) {
+    int nArgs = *ip++;
+    DO_CALL_SITE(nArgs, true);
+    break;
+}
+// fn local* ... callable a1 a2 a3 a4 ... aFFFF]
+// callable a1 a2 a3 a4 ... aFFFF]
+INSTR(TAIL_CALL_S) {
+    int nArgs = READ_U16();
+    ip += 2;
+    DO_CALL_SITE(nArgs, true);
+    break;
+}
+// ... self a1 ... aN]
+// ... self a1 ... aN]
+INSTR(SELF_CALL) {
+    DO_SELF_CALL(false);
+    break;
+}
+// fn local* ... self a1 ... aN]
+// self a1 ... aN]
+INSTR(TAIL_SELF_CALL) {
+    DO_SELF_CALL(true);
+    break;
+}
+// -------------------------------------------------------------------------
+// Inlined core procs. The compiler emits these in place of a call to the
+// sxp/+ etc. procs, see emitInlineProc(). Same result, no frame. Most
+// quicken to an _INT form after seeing fixnums, see QUICKEN().
+
+// ... x y]
+// ... sum]
+INSTR(ADD) {
+    Obj* y = ppop();
+    if (isFixnum(sp[-1]) && isFixnum(y))
+        QUICKEN(ADD_INT_INT);
+    sp[-1] = rt::add(sp[-1], y);
+    break;
+}
+// ... x y]
+// ... dif]
+INSTR(SUB) {
+    Obj* y = ppop();
+    if (isFixnum(sp[-1]) && isFixnum(y))
+        QUICKEN(SUB_INT_INT);
+    sp[-1] = rt::sub(sp[-1], y);
+    break;
+}
+// ... x y]
+// ... product]
+INSTR(MUL) {
+    Obj* y = ppop();
+    sp[-1] = rt::mul(sp[-1], y);
+    break;
+}
+// ... x y]
+// ... quotient]
+INSTR(DIV) {
+    Obj* y = ppop();
+    sp[-1] = rt::div(sp[-1], y);
+    break;
+}
+// ... x y]
+// ... bool]
+INSTR(EQEQ) {
+    Obj* y = ppop();
+    if (isFixnum(sp[-1]) && isFixnum(y))
+        QUICKEN(EQEQ_INT_INT);
+    sp[-1] = rt::numEq(sp[-1], y) ? rt::T : rt::F;
+    break;
+}
+// ... x y]
+// ... bool]
+INSTR(LT) {
+    Obj* y = ppop();
+    if (isFixnum(sp[-1]) && isFixnum(y))
+        QUICKEN(LT_INT_INT);
+    sp[-1] = rt::lt(sp[-1], y) ? rt::T : rt::F;
+    break;
+}
+// ... x y]
+// ... bool]
+INSTR(EQ) {
+    Obj* y = ppop();
+    sp[-1] = rt::isEqualTo(sp[-1], y) ? rt::T : rt::F;
+    break;
+}
+// ... x]
+// ... x+1]
+INSTR(INC) {
+    if (isFixnum(sp[-1]))
+        QUICKEN(INC_INT);
+    sp[-1] = rt::add(sp[-1], makeFixnum(1));
+    break;
+}
+// ... x]
+// ... x-1]
+INSTR(DEC) {
+    if (isFixnum(sp[-1]))
+        QUICKEN(DEC_INT);
+    sp[-1] = rt::sub(sp[-1], makeFixnum(1));
+    break;
+}
+// ... coll i]
+// ... ith-obj]
+INSTR(NTH) {
+    Obj* i = ppop();
+    if (pVector(sp[-1]) && isFixnum(i))
+        QUICKEN(NTH_VECTOR);
+    sp[-1] = rt::nth(sp[-1], cpINumber(i)->toInt());
+    break;
+}
+// -------------------------------------------------------------------------
+// Quickened forms of the above. Each guards on its operand types and falls
+// back to DEOPT() and the generic code when they don't match.
+
+// ... x y]
+// ... sum]
+INSTR(ADD_INT_INT) {
+    Obj* y = ppop();
+    Obj* x = sp[-1];
+    if (isFixnum(x) && isFixnum(y))
+        sp[-1] = Integer::fetch(fixnumVal(x) + fixnumVal(y));
+    else {
+        DEOPT(ADD);
+        sp[-1] = rt::add(x, y);
+    }
+    break;
+}
+// ... x y]
+// ... dif]
+INSTR(SUB_INT_INT) {
+    Obj* y = ppop();
+    Obj* x = sp[-1];
+    if (isFixnum(x) && isFixnum(y))
+        sp[-1] = Integer::fetch(fixnumVal(x) - fixnumVal(y));
+    else {
+        DEOPT(SUB);
+        sp[-1] = rt::sub(x, y);
+    }
+    break;
+}
+// ... x y]
+// ... bool]
+INSTR(LT_INT_INT) {
+    Obj* y = ppop();
+    Obj* x = sp[-1];
+    if (isFixnum(x) && isFixnum(y))
+        sp[-1] = fixnumVal(x) < fixnumVal(y) ? rt::T : rt::F;
+    else {
+        DEOPT(LT);
+        sp[-1] = rt::lt(x, y) ? rt::T : rt::F;
+    }
+    break;
+}
+// ... x y]
+// ... bool]
+INSTR(EQEQ_INT_INT) {
+    Obj* y = ppop();
+    Obj* x = sp[-1];
+    if (isFixnum(x) && isFixnum(y))
+        sp[-1] = x == y ? rt::T : rt::F;
+    else {
+        DEOPT(EQEQ);
+        sp[-1] = rt::numEq(x, y) ? rt::T : rt::F;
+    }
+    break;
+}
+// ... x]
+// ... x+1]
+INSTR(INC_INT) {
+    Obj* x = sp[-1];
+    if (isFixnum(x))
+        sp[-1] = Integer::fetch(fixnumVal(x) + 1);
+    else {
+        DEOPT(INC);
+        sp[-1] = rt::add(x, makeFixnum(1));
+    }
+    break;
+}
+// ... x]
+// ... x-1]
+INSTR(DEC_INT) {
+    Obj* x = sp[-1];
+    if (isFixnum(x))
+        sp[-1] = Integer::fetch(fixnumVal(x) - 1);
+    else {
+        DEOPT(DEC);
+        sp[-1] = rt::sub(x, makeFixnum(1));
+    }
+    break;
+}
+// ... coll i]
+// ... ith-obj]
+INSTR(NTH_VECTOR) {
+    Obj* i = ppop();
+    Vector* v = pVector(sp[-1]);
+    if (v && isFixnum(i)) {
+        const VecTrie& impl = v->impl();
+        if (fixnumVal(i) >= 0 && fixnumVal(i) < (long)impl.size()) {
+            sp[-1] = impl[fixnumVal(i)];
+            break;
+        }
+    }
+    else
+        DEOPT(NTH);
+    // out of bounds, let Vector::nth() throw
+    sp[-1] = rt::nth(sp[-1], cpINumber(i)->toInt());
+    break;
+}
+// -------------------------------------------------------------------------
+// Superinstructions, see vasm::peephole()
+
+// ...]
+// ... x]
+INSTR(LOAD_VAR) {
+    ppush(pVar(curFrame->cp[*ip++])->get());
+    break;
+}
+// ...]
+// ... x y]
+INSTR(LOAD_LOCAL_LOAD_LOCAL) {
+    ppush(curFrame->locals[ip[0]]);
+    ppush(curFrame->locals[ip[1]]);
+    ip += 2;
+    break;
+}
+// ...]
+// ... x y]
+INSTR(LOAD_LOCAL_LOAD_CONST) {
+    ppush(curFrame->locals[ip[0]]);
+    ppush(curFrame->cp[ip[1]]);
+    ip += 2;
+    break;
+}
+// ... x y]
+// ...]
+INSTR(LT_JUMP_IF_FALSE) {
+    Obj* y = ppop();
+    if (isFixnum(ppeek()) && isFixnum(y))
+        QUICKEN(LT_INT_INT_JUMP_IF_FALSE);
+    if (!rt::lt(ppop(), y))
+        ip = curFrame->code + READ_U16();
+    else
+        ip += 2;
+    break;
+}
+// ... x y]
+// ...]
+INSTR(EQEQ_JUMP_IF_FALSE) {
+    Obj* y = ppop();
+    if (isFixnum(ppeek()) && isFixnum(y))
+        QUICKEN(EQEQ_INT_INT_JUMP_IF_FALSE);
+    if (!rt::numEq(ppop(), y))
+        ip = curFrame->code + READ_U16();
+    else
+        ip += 2;
+    break;
+}
+// ... x y]
+// ...]
+INSTR(LT_INT_INT_JUMP_IF_FALSE) {
+    Obj* y = ppop();
+    Obj* x = ppop();
+    bool b;
+    if (isFixnum(x) && isFixnum(y))
+        b = fixnumVal(x) < fixnumVal(y);
+    else {
+        DEOPT(LT_JUMP_IF_FALSE);
+        b = rt::lt(x, y);
+    }
+    if (!b)
+        ip = curFrame->code + READ_U16();
+    else
+        ip += 2;
+    break;
+}
+// ... x y]
+// ...]
+INSTR(EQEQ_INT_INT_JUMP_IF_FALSE) {
+    Obj* y = ppop();
+    Obj* x = ppop();
+    bool b;
+    if (isFixnum(x) && isFixnum(y))
+        b = x == y;
+    else {
+        DEOPT(EQEQ_JUMP_IF_FALSE);
+        b = rt::numEq(x, y);
+    }
+    if (!b)
+        ip = curFrame->code + READ_U16();
+    else
+        ip += 2;
     break;
 }
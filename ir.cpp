@@ -0,0 +1,755 @@
+/*
+  ir.cpp
+  S. Edward Dolan
+  Saturday, October 17 2026
+
+  The stage between the reader and the bytecode emitter. compile() lowers
+  each top-level form before emitting it. The IR is still a form, but one
+  in which every macro call has been expanded, so all that is left are
+  special forms, calls, symbols and literals. (ir form) returns it.
+
+  Lowering also marks each local binding that is assigned after it is made,
+  by set! or by a recur to its loop or fn, see Walker::binding().
+
+  While lowering, a call to a pure core fn whose args are all constant is
+  replaced by its value, an if with a constant test by the branch it would
+  take, and a form with no effect before the last in a body is dropped.
+  So (cond (== 1 2) a :else b) lowers to b. Folding, like the inline
+  procs, assumes the core fns have not been redefined and is off while
+  *inline-procs* is false.
+
+  Lowering is also where calls to small fns are inlined. A def of a symbol
+  with {:inline true} meta whose value is a single arity fn with fixed
+  parameters, e.g.
+
+    (defn #^{:inline true} point-x [p] (nth p 0))
+
+  keeps the lowered fn body as a template, its global symbols qualified so
+  it means the same thing wherever it is expanded. A later (point-x q) is
+  then lowered to
+
+    (let* [p__12__AUTO__ q] (sxp/nth p__12__AUTO__ 0))
+
+  A constant argument, a literal or a quoted form, is substituted for its
+  parameter instead of being bound, unless the body set!s the parameter.
+  As with a macro, the expansion is fixed at the call site, so redefining
+  an inline fn only affects code compiled afterwards. Bind *inline-fns* to
+  false to compile ordinary calls.
+*/
+
+#include "sxp.hpp"
+
+namespace ir {
+
+// the largest fn body, in atoms and collections, that will be inlined
+#define MAX_INLINE_SIZE 64
+
+struct Inline : gc {
+    Namespace* ns;              // where the fn was defined
+    vecobj_t params;
+    vecobj_t body;              // lowered, globals qualified
+    std::vector<bool> mutated;  // params the body set!s
+    bool nsOnly;                // body refers to a private var or an import
+};
+
+typedef std::unordered_map<Var*,
+                           Inline*,
+                           std::hash<Var*>,
+                           std::equal_to<Var*>,
+                           gc_allocator<std::pair<Var* const,
+                                                  Inline*>>> inlinemap_t;
+
+static inlinemap_t inlines;
+
+static vecobj_t toVec(Obj* s) {
+    vecobj_t v;
+    for (s=rt::seq(s); s!=NIL; s=rt::next(s))
+        v.push_back(rt::first(s));
+    return v;
+}
+
+// Return list if v holds the same elements, else a new list with its meta
+static List* rebuild(List* list, const vecobj_t& v) {
+    if (v == toVec(list))
+        return list;
+    List* x = List::create(v);
+    if (list->meta())
+        x->withMeta(list->meta());
+    return x;
+}
+
+static int sizeOf(Obj* form) {
+    int n = 1;
+    if (pList(form) || pVector(form))
+        for (Obj* s=rt::seq(form); s!=NIL; s=rt::next(s))
+            n += sizeOf(rt::first(s));
+    return n;
+}
+
+// a self-evaluating atom
+static bool isLiteral(Obj* x) {
+    return x == NIL || x == rt::T || x == rt::F || isImmediate(x)
+        || pINumber(x) || pString(x) || pKeyword(x) || pCharacter(x);
+}
+
+static bool isConstant(Obj* x) {
+    if (isLiteral(x))
+        return true;
+    List* lst = pList(x);
+    return lst && rt::isEqualTo(rt::first(lst), rt::SYM_QUOTE);
+}
+
+// If form always evaluates to an equal value, without side effects, set
+// value to it and return true.
+static bool constValue(Obj* form, Obj*& value) {
+    if (isLiteral(form)) {
+        value = form;
+        return true;
+    }
+    if (List* lst = pList(form)) {
+        if (lst->isEmpty())
+            value = lst;
+        else if (rt::isEqualTo(rt::first(lst), rt::SYM_QUOTE) &&
+                 rt::count(lst) == 2)
+            value = rt::second(lst);
+        else
+            return false;
+        return true;
+    }
+    if (Vector* v = pVector(form)) {
+        vecobj_t x;
+        for (auto e : v->impl()) {
+            Obj* y;
+            if (!constValue(e, y))
+                return false;
+            x.push_back(y);
+        }
+        value = Vector::create(x);
+        return true;
+    }
+    return false;
+}
+
+/*
+  Rebuild a lowered form, knowing which symbols each special form binds.
+  Subclasses rewrite symbols or lists along the way. A malformed special
+  form is passed through untouched for the emitter to complain about.
+*/
+struct Walker {
+    virtual ~Walker() {}
+    Obj* walk(Obj* form);
+protected:
+    vecobj_t env;               // symbols bound around the current form
+    std::vector<bool> assigned; // env[i] is set! or rebound by recur
+    // the env ranges bound by the fn methods and loops around it
+    std::vector<std::pair<size_t, size_t>> recurTargets;
+    void bind(Obj* sym) { env.push_back(sym); assigned.push_back(false); }
+    void unbind(size_t mark) { env.resize(mark); assigned.resize(mark); }
+    Obj* binding(size_t i, Obj* sym);
+    // a symbol in an evaluated position
+    virtual Obj* symbol(Symbol* sym) { return sym; }
+    // the symbol assigned by set!
+    virtual Obj* target(Symbol* sym) { return symbol(sym); }
+    // a non-empty list
+    virtual Obj* list(List* form) { return walkList(form); }
+    // a special form, before it is walked
+    virtual void special(Symbol* head, List* form) { (void)head; (void)form; }
+    // the forms v[i..] of a body, after they are walked
+    virtual void body(vecobj_t& v, size_t i) { (void)v; (void)i; }
+    int localIndex(Symbol* sym);
+    Obj* walkList(List* form);
+    void walkFn(vecobj_t& v, size_t i);
+    void walkMethod(vecobj_t& v, size_t i);
+    void walkBindings(vecobj_t& v, bool isLoop);
+    void walkLetfn(vecobj_t& v);
+    void walkTry(vecobj_t& v);
+};
+
+Obj* Walker::walk(Obj* form) {
+    if (Symbol* sym = pSymbol(form))
+        return symbol(sym);
+    if (List* lst = pList(form))
+        return lst->isEmpty() ? lst : list(lst);
+    if (Vector* v = pVector(form)) {
+        vecobj_t x;
+        for (auto e : v->impl())
+            x.push_back(walk(e));
+        return x == v->impl().vec() ? v
+                                    : Vector::create(x)->withMeta(v->meta());
+    }
+    if (Hashmap* m = pHashmap(form)) {
+        vecobj_t kvs;
+        bool changed = false;
+        for (auto e : m->impl()) {
+            kvs.push_back(walk(e.first));
+            kvs.push_back(walk(e.second));
+            changed |= kvs.end()[-2] != e.first || kvs.back() != e.second;
+        }
+        return changed ? Hashmap::create(kvs)->withMeta(m->meta()) : m;
+    }
+    if (Hashset* s = pHashset(form)) {
+        vecobj_t x;
+        bool changed = false;
+        for (auto e : s->impl()) {
+            x.push_back(walk(e));
+            changed |= x.back() != e;
+        }
+        return changed ? Hashset::create(x)->withMeta(s->meta()) : s;
+    }
+    return form;
+}
+
+/*
+  Return sym, the symbol that made binding env[i], with {:mutable true}
+  meta when the binding is assigned after it is made. The emitter boxes a
+  mutable local that a closure captures in an Upval, shared with the frame,
+  and copies any other into the closure.
+*/
+Obj* Walker::binding(size_t i, Obj* sym) {
+    Symbol* s = pSymbol(sym);
+    if (!s || !assigned[i] || rt::toBool(rt::get(s->meta(), rt::KW_MUTABLE)))
+        return sym;
+    Hashmap* m = cpHashmap(rt::assoc(s->meta(), rt::KW_MUTABLE, rt::T));
+    return Symbol::create(s->nsName(), s->name())->withMeta(m);
+}
+
+// Return the env index of the innermost binding of sym, or -1
+int Walker::localIndex(Symbol* sym) {
+    if (!sym->hasNS())
+        for (int i=env.size()-1; i>=0; --i)
+            if (rt::isEqualTo(sym, env[i]))
+                return i;
+    return -1;
+}
+
+Obj* Walker::walkList(List* form) {
+    vecobj_t v = toVec(form);
+    Symbol* head = pSymbol(v[0]);
+    size_t i = 0;               // first element to walk
+    if (head && rt::isSpecial(head)) {
+        special(head, form);
+        i = v.size();
+        if (rt::isEqualTo(head, rt::SYM_QUOTE) ||
+            rt::isEqualTo(head, rt::SYM_VAR))
+            return form;
+        else if (rt::isEqualTo(head, rt::SYM_FN))
+            walkFn(v, 1);
+        else if (rt::isEqualTo(head, rt::SYM_LET))
+            walkBindings(v, false);
+        else if (rt::isEqualTo(head, rt::SYM_LOOP))
+            walkBindings(v, true);
+        else if (rt::isEqualTo(head, rt::SYM_LETFN))
+            walkLetfn(v);
+        else if (rt::isEqualTo(head, rt::SYM_TRY))
+            walkTry(v);
+        else if (rt::isEqualTo(head, rt::SYM_SET_BANG)) {
+            if (v.size() > 1 && pSymbol(v[1])) {
+                int j = localIndex(pSymbol(v[1]));
+                if (j >= 0)
+                    assigned[j] = true;
+                v[1] = target(pSymbol(v[1]));
+            }
+            i = 2;
+        }
+        else if (rt::isEqualTo(head, rt::SYM_RECUR)) {
+            if (!recurTargets.empty())
+                for (size_t j=recurTargets.back().first;
+                     j<recurTargets.back().second; ++j)
+                    assigned[j] = true;
+            i = 1;
+        }
+        else if (rt::isEqualTo(head, rt::SYM_DEF))
+            i = 2;
+        else
+            i = 1;
+    }
+    for (; i<v.size(); ++i)
+        v[i] = walk(v[i]);
+    if (head && rt::isEqualTo(head, rt::SYM_DO))
+        body(v, 1);
+    return rebuild(form, v);
+}
+
+// name? [params] body*  or  name? ([params] body*)+  starting at v[i]
+void Walker::walkFn(vecobj_t& v, size_t i) {
+    size_t mark = env.size();
+    size_t name = i;
+    if (i < v.size() && pSymbol(v[i]))
+        bind(v[i++]);
+    if (i < v.size() && pVector(v[i]))
+        walkMethod(v, i);
+    else
+        for (; i<v.size(); ++i)
+            if (List* m = pList(v[i])) {
+                vecobj_t mv = toVec(m);
+                if (!mv.empty()) {
+                    walkMethod(mv, 0);
+                    v[i] = rebuild(m, mv);
+                }
+            }
+    if (env.size() > mark)
+        v[name] = binding(mark, v[name]);
+    unbind(mark);
+}
+
+// [params] body*  starting at v[i]
+void Walker::walkMethod(vecobj_t& v, size_t i) {
+    size_t mark = env.size();
+    Vector* params = pVector(v[i]);
+    if (params)
+        for (auto p : params->impl())
+            if (pSymbol(p) && !rt::isEqualTo(p, rt::SYM_AMP))
+                bind(p);
+    recurTargets.push_back({mark, env.size()});
+    for (size_t j=i+1; j<v.size(); ++j)
+        v[j] = walk(v[j]);
+    recurTargets.pop_back();
+    body(v, i + 1);
+    if (params) {
+        vecobj_t x = params->impl().vec();
+        for (size_t j=0, k=mark; j<x.size(); ++j)
+            if (pSymbol(x[j]) && !rt::isEqualTo(x[j], rt::SYM_AMP))
+                x[j] = binding(k++, x[j]);
+        if (x != params->impl().vec())
+            v[i] = Vector::create(x)->withMeta(params->meta());
+    }
+    unbind(mark);
+}
+
+// (let* [sym val ...] body*)  or  (loop [sym val ...] body*)
+void Walker::walkBindings(vecobj_t& v, bool isLoop) {
+    size_t mark = env.size();
+    Vector* b = v.size() > 1 ? pVector(v[1]) : nullptr;
+    vecobj_t x;
+    if (b) {
+        x = b->impl().vec();
+        for (size_t j=1; j<x.size(); j+=2) {
+            x[j] = walk(x[j]);
+            bind(x[j - 1]);
+        }
+    }
+    if (isLoop)
+        recurTargets.push_back({mark, env.size()});
+    for (size_t i=2; i<v.size(); ++i)
+        v[i] = walk(v[i]);
+    if (isLoop)
+        recurTargets.pop_back();
+    body(v, 2);
+    if (b) {
+        for (size_t j=1; j<x.size(); j+=2)
+            x[j - 1] = binding(mark + j / 2, x[j - 1]);
+        if (x != b->impl().vec())
+            v[1] = Vector::create(x)->withMeta(b->meta());
+    }
+    unbind(mark);
+}
+
+// (letfn [name (name? [params] body*) ...] body*)
+void Walker::walkLetfn(vecobj_t& v) {
+    size_t mark = env.size();
+    if (Vector* b = v.size() > 1 ? pVector(v[1]) : nullptr) {
+        vecobj_t x = b->impl().vec();
+        // each fn may capture the names before they are all stored
+        for (size_t j=0; j<x.size(); j+=2) {
+            bind(x[j]);
+            assigned.back() = true;
+            x[j] = binding(env.size() - 1, x[j]);
+        }
+        for (size_t j=1; j<x.size(); j+=2)
+            if (List* f = pList(x[j])) {
+                vecobj_t fv = toVec(f);
+                walkFn(fv, 0);
+                x[j] = rebuild(f, fv);
+            }
+        if (x != b->impl().vec())
+            v[1] = Vector::create(x)->withMeta(b->meta());
+    }
+    for (size_t i=2; i<v.size(); ++i)
+        v[i] = walk(v[i]);
+    body(v, 2);
+    unbind(mark);
+}
+
+// (try expr* (catch type sym body*)* (finally body*)?)
+void Walker::walkTry(vecobj_t& v) {
+    for (size_t i=1; i<v.size(); ++i) {
+        List* c = pList(v[i]);
+        Obj* head = c ? rt::first(c) : NIL;
+        if (head && rt::isEqualTo(head, rt::SYM_CATCH)) {
+            vecobj_t cv = toVec(c);
+            size_t mark = env.size();
+            if (cv.size() > 2)
+                bind(cv[2]);
+            for (size_t j=3; j<cv.size(); ++j)
+                cv[j] = walk(cv[j]);
+            body(cv, 3);
+            if (cv.size() > 2)
+                cv[2] = binding(mark, cv[2]);
+            unbind(mark);
+            v[i] = rebuild(c, cv);
+        }
+        else if (head && rt::isEqualTo(head, rt::SYM_FINALLY)) {
+            vecobj_t fv = toVec(c);
+            for (size_t j=1; j<fv.size(); ++j)
+                fv[j] = walk(fv[j]);
+            body(fv, 1);
+            v[i] = rebuild(c, fv);
+        }
+        else
+            v[i] = walk(v[i]);
+    }
+}
+
+// =========================================================================
+//                             Inline Templates
+
+// Qualify the global symbols of an inline fn's lowered body, checking that
+// it can be expanded anywhere.
+struct Template : Walker {
+    Template(Inline* in, Var* var, Symbol* self, const vecobj_t& outer)
+        : in(in), var(var), self(self), outer(outer) {
+        for (auto p : in->params)
+            bind(p);
+    }
+    std::string why;            // why it cannot be inlined
+protected:
+    Inline* in;
+    Var* var;
+    Symbol* self;               // the fn's own name, or nullptr
+    const vecobj_t& outer;      // locals around the def
+    void fail(const std::string& s) { if (why.empty()) why = s; }
+    Obj* symbol(Symbol* sym);
+    Obj* target(Symbol* sym);
+    void special(Symbol* head, List* form);
+};
+
+Obj* Template::symbol(Symbol* sym) {
+    if (localIndex(sym) >= 0)
+        return sym;
+    if (self && rt::isEqualTo(sym, self)) {
+        fail("is recursive");
+        return sym;
+    }
+    for (auto o : outer)
+        if (rt::isEqualTo(sym, o)) {
+            fail("closes over the local " + sym->toString());
+            return sym;
+        }
+    Obj* o;
+    try {
+        o = compiler::resolve(sym);
+    }
+    catch (SxError&) {
+        fail("refers to the unresolved symbol " + sym->toString());
+        return sym;
+    }
+    Var* gv = pVar(o);
+    if (!gv) {
+        in->nsOnly = true;      // an import
+        return sym;
+    }
+    if (gv == var) {
+        fail("is recursive");
+        return sym;
+    }
+    if (!gv->isPublic())
+        in->nsOnly = true;
+    Symbol* q = Symbol::create(gv->ns()->name()->name(), gv->sym()->name());
+    try {
+        if (compiler::resolve(q) == gv)
+            return q;
+    }
+    catch (SxError&) {}
+    in->nsOnly = true;
+    return sym;
+}
+
+Obj* Template::target(Symbol* sym) {
+    int i = localIndex(sym);
+    if (i >= 0 && i < static_cast<int>(in->params.size()))
+        in->mutated[i] = true;
+    return symbol(sym);
+}
+
+void Template::special(Symbol* head, List* form) {
+    (void)form;
+    if (rt::isEqualTo(head, rt::SYM_RECUR) && recurTargets.empty())
+        fail("recurs");
+    else if (rt::isEqualTo(head, rt::SYM_DEF))
+        fail("contains a def");
+    else if (rt::isEqualTo(head, rt::SYM_VAR) ||
+             rt::isEqualTo(head, rt::SYM_TRY))
+        in->nsOnly = true;      // unqualified var or catch type symbols
+}
+
+// Return the template for the lowered fn form bound to var, or set why
+static Inline* makeInline(Obj* value, Var* var, const vecobj_t& outer,
+                          std::string& why) {
+    List* fn = pList(value);
+    if (!fn || !rt::isEqualTo(rt::first(fn), rt::SYM_FN)) {
+        why = "is not bound to a fn form";
+        return nullptr;
+    }
+    vecobj_t v = toVec(fn);
+    size_t i = 1;
+    Symbol* self = i < v.size() ? pSymbol(v[i]) : nullptr;
+    if (self)
+        ++i;
+    if (i + 1 == v.size() && pList(v[i])) {
+        v = toVec(v[i]);        // (fn name? ([params] body*))
+        i = 0;
+    }
+    Vector* params = i < v.size() ? pVector(v[i]) : nullptr;
+    if (!params) {
+        why = "has more than one arity";
+        return nullptr;
+    }
+    Inline* in = new Inline;
+    in->ns = rt::currentNS();
+    in->nsOnly = false;
+    for (auto p : params->impl()) {
+        if (!pSymbol(p) || rt::isEqualTo(p, rt::SYM_AMP)) {
+            why = "has a rest parameter";
+            return nullptr;
+        }
+        in->params.push_back(p);
+    }
+    in->mutated.resize(in->params.size());
+    Template t(in, var, self, outer);
+    int size = 0;
+    for (++i; i<v.size(); ++i) {
+        size += sizeOf(v[i]);
+        in->body.push_back(t.walk(v[i]));
+    }
+    why = t.why;
+    if (why.empty() && size > MAX_INLINE_SIZE)
+        why = "is too big";
+    return why.empty() ? in : nullptr;
+}
+
+// Bind a template's parameters to the arguments of one call
+struct Substitution : Walker {
+    Substitution(const vecobj_t& params, const vecobj_t& args)
+        : params(params), args(args) {}
+protected:
+    const vecobj_t& params;
+    const vecobj_t& args;
+    Obj* symbol(Symbol* sym) {
+        if (localIndex(sym) < 0)
+            for (int i=params.size()-1; i>=0; --i)
+                if (rt::isEqualTo(sym, params[i]))
+                    return args[i];
+        return sym;
+    }
+};
+
+// =========================================================================
+//                                Lowering
+
+struct Lowerer : Walker {
+protected:
+    Obj* list(List* form);
+    void body(vecobj_t& v, size_t i);
+    Obj* simplify(List* form, Symbol* head);
+    Obj* propagate(List* form);
+    Obj* expandInline(List* form, Symbol* head);
+    void define(Var* var, List* form);
+};
+
+// The sxp fns and procs that only compute a value from their args, called
+// at compile time when every arg is constant.
+static const std::unordered_set<std::string> PURE_FNS = {
+    "+", "-", "*", "/", "==", "<", ">", "<=", ">=", "=", "not=", "inc",
+    "dec", "int", "float", "not", "nil?", "some?", "true?", "false?",
+    "zero?", "pos?", "neg?", "identical?", "str", "count", "nth", "get",
+    "contains?", "keyword", "name", "typename", "number?", "integer?",
+    "float?", "string?", "keyword?", "character?", "symbol?", "bool?",
+    "list?", "vector?"
+};
+
+// Intern the var (def name ...) will bind, as the emitter does before it
+// emits the value, so the value can refer to it.
+static Var* defVar(Obj* name) {
+    Symbol* sym = pSymbol(name);
+    Namespace* ns = rt::currentNS();
+    if (!sym ||
+        rt::isEqualTo(sym, rt::SYM_NS) ||
+        rt::isEqualTo(sym, rt::SYM_IN_NS))
+        return nullptr;
+    if (sym->hasNS()) {
+        if (sym->nsName() != ns->name()->name())
+            return nullptr;
+        sym = Symbol::create(sym->name());
+    }
+    Obj* o = ns->get(sym);
+    Var* var = pVar(o);
+    if (o && !var)
+        return nullptr;         // the emitter will complain
+    return var && var->ns() == ns ? var : ns->intern(sym);
+}
+
+Obj* Lowerer::list(List* form) {
+    Symbol* head = pSymbol(form->first());
+    if (head && !rt::isSpecial(head) && localIndex(head) < 0) {
+        Obj* x = compiler::macroExpand1(form);
+        if (x != form)
+            return walk(x);
+        if ((x = expandInline(form, head)))
+            return walk(x);
+    }
+    Var* var = nullptr;
+    if (head && rt::isEqualTo(head, rt::SYM_DEF))
+        var = defVar(rt::second(form));
+    Obj* x = walkList(form);
+    if (var && pList(x))
+        define(var, pList(x));
+    else if (pList(x))
+        x = simplify(pList(x), head);
+    return x;
+}
+
+/*
+  Substitute each constant let* binding that is never assigned for its
+  symbol, and drop it:
+
+    (let* [k 3 f (fn [x] (+ x k))] ...)  =>  (let* [f (fn [x] (+ x 3))] ...)
+
+  A fn that only captured such locals no longer captures anything, so it is
+  emitted as a constant Fn instead of a NEW_CLOSURE.
+*/
+Obj* Lowerer::propagate(List* form) {
+    vecobj_t v = toVec(form);
+    Vector* b = v.size() > 1 ? pVector(v[1]) : nullptr;
+    if (!b || b->count() % 2)
+        return form;
+    vecobj_t x = b->impl().vec(), kept;
+    for (size_t i=0; i<x.size(); i+=2) {
+        Symbol* sym = pSymbol(x[i]);
+        if (!sym || !isConstant(x[i + 1]) ||
+            rt::toBool(rt::get(sym->meta(), rt::KW_MUTABLE))) {
+            kept.push_back(x[i]);
+            kept.push_back(x[i + 1]);
+            continue;
+        }
+        vecobj_t params {sym}, args {x[i + 1]};
+        Substitution sub(params, args);
+        size_t j = i + 2;
+        for (; j<x.size(); j+=2) {
+            x[j + 1] = sub.walk(x[j + 1]);
+            if (rt::isEqualTo(x[j], sym))
+                break;          // rebound, the rest see the new binding
+        }
+        if (j >= x.size())
+            for (size_t k=2; k<v.size(); ++k)
+                v[k] = sub.walk(v[k]);
+    }
+    if (kept.size() == x.size())
+        return form;
+    v[1] = Vector::create(kept)->withMeta(b->meta());
+    return rebuild(form, v);
+}
+
+// Drop the forms before the last that have no effect
+void Lowerer::body(vecobj_t& v, size_t i) {
+    vecobj_t x(v.begin(), v.begin() + std::min(i, v.size()));
+    for (; i<v.size(); ++i) {
+        Symbol* sym = pSymbol(v[i]);
+        Obj* value;
+        if (i + 1 < v.size() &&
+            ((sym && localIndex(sym) >= 0) || constValue(v[i], value)))
+            continue;
+        x.push_back(v[i]);
+    }
+    v = x;
+}
+
+// Reduce an if with a constant test to the branch taken, and a call to a
+// pure fn with constant args to its value.
+Obj* Lowerer::simplify(List* form, Symbol* head) {
+    if (!head)
+        return form;
+    Obj* value;
+    if (rt::isEqualTo(head, rt::SYM_LET))
+        return propagate(form);
+    if (rt::isEqualTo(head, rt::SYM_IF)) {
+        vecobj_t v = toVec(form);
+        if ((v.size() == 3 || v.size() == 4) && constValue(v[1], value))
+            return rt::toBool(value) ? v[2] : v.size() == 4 ? v[3] : NIL;
+        return form;
+    }
+    if (rt::isSpecial(head) || localIndex(head) >= 0 || !rt::inlineProcs())
+        return form;
+    Var* var = pVar(compiler::resolve(head));
+    if (!var || var->ns() != rt::sxpNS() || var->isDynamic() ||
+        !PURE_FNS.count(var->sym()->name()))
+        return form;
+    vecobj_t args;
+    for (Obj* s=rt::next(form); s!=NIL; s=rt::next(s)) {
+        if (!constValue(rt::first(s), value))
+            return form;
+        args.push_back(value);
+    }
+    try {
+        value = compiler::callNow(var->get(), args);
+    }
+    catch (SxError&) {
+        return form;            // leave the error for run time
+    }
+    return isLiteral(value) ? value : form;
+}
+
+// (f arg ...) => (let* [param__N__AUTO__ arg ...] body*)
+Obj* Lowerer::expandInline(List* form, Symbol* head) {
+    if (inlines.empty() || !rt::inlineFns())
+        return nullptr;
+    Var* var = pVar(compiler::resolve(head));
+    auto itr = inlines.find(var);
+    if (!var || itr == inlines.end() || var->isDynamic())
+        return nullptr;
+    Inline* in = itr->second;
+    if ((in->nsOnly && in->ns != rt::currentNS()) ||
+        rt::count(form) - 1 != static_cast<int>(in->params.size()))
+        return nullptr;
+    vecobj_t bindings, args;
+    int i = 0;
+    for (Obj* s=rt::next(form); s!=NIL; s=rt::next(s), ++i) {
+        Obj* arg = rt::first(s);
+        if (isConstant(arg) && !in->mutated[i])
+            args.push_back(arg);
+        else {
+            Symbol* g = rt::genSym(pSymbol(in->params[i])->name() + "__",
+                                   "__AUTO__");
+            bindings.push_back(g);
+            bindings.push_back(arg);
+            args.push_back(g);
+        }
+    }
+    Substitution sub(in->params, args);
+    vecobj_t x {rt::SYM_LET, Vector::create(bindings)};
+    for (auto e : in->body)
+        x.push_back(sub.walk(e));
+    return List::create(x);
+}
+
+// Record, or forget, the template for the var a lowered (def ...) names
+void Lowerer::define(Var* var, List* form) {
+    Symbol* sym = pSymbol(rt::second(form));
+    if (!rt::toBool(rt::get(sym->meta(), rt::KW_INLINE))) {
+        inlines.erase(var);
+        return;
+    }
+    std::string why;
+    if (Inline* in = makeInline(rt::third(form), var, env, why))
+        inlines[var] = in;
+    else {
+        inlines.erase(var);
+        rt::warning("not inlining " + var->toString() + ", it " + why);
+    }
+}
+
+Obj* lower(Obj* form) {
+    Lowerer l;
+    return l.walk(form);
+}
+
+} // end namespace ir
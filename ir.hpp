@@ -0,0 +1,17 @@
+/*
+  ir.hpp
+  S. Edward Dolan
+  Saturday, October 17 2026
+*/
+
+#ifndef IR_HPP_INCLUDED
+#define IR_HPP_INCLUDED
+
+namespace ir {
+
+// Return form fully macroexpanded, with calls to :inline fns inlined.
+Obj* lower(Obj* form);
+
+}
+
+#endif // IR_HPP_INCLUDED
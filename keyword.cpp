@@ -33,7 +33,7 @@ Keyword::Keyword(const std::string& name)
     : Fn("SxKeyword"),
       _name(name),
       _hash(std::hash<std::string>()(":" + name)) {
-    _typeName = "SxKeyword";
+    _typeId = TID_Keyword;
     createMethods();
 }
 
@@ -14,7 +14,7 @@ LazySeq::LazySeq(Obj* fn)
     : _fn(fn),
       _sv(nullptr),
       _s(nullptr) {
-    _typeName = "SxLazySeq";
+    _typeId = TID_LazySeq;
 }
 
 std::string LazySeq::toString() {
@@ -31,7 +31,7 @@ std::string LazySeq::toString() {
 
 size_t LazySeq::getHash() {
     std::stringstream ss;
-    ss << _typeName << " is not hashable";
+    ss << typeName() << " is not hashable";
     throw SxRuntimeError(ss.str());
 }
 
@@ -43,8 +43,8 @@ bool LazySeq::isEqualTo(Obj* x) {
 
 Obj* LazySeq::sval() {
     if (_fn) {
-        VM vm;
-        _sv = vm.run(_fn);
+        PooledVM vm;
+        _sv = vm->run(_fn);
         _fn = NIL;
     }
     if (_sv)
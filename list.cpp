@@ -43,8 +43,15 @@ List* List::create(vecobj_t v) {
     return static_cast<List*>(s);
 }
 
+List* List::create(const VecTrie& v) {
+    ISeq* s = List::create();
+    for (size_t i=v.size(); i>0; --i)
+        s = s->cons(v[i - 1]);
+    return static_cast<List*>(s);
+}
+
 List::List() : _head(EMPTY_LIST_MARKER), _tail(NIL), _meta(nullptr) {
-    _typeName = "SxList";
+    _typeId = TID_List;
 }
 
 List::List(Obj* obj) : List() {
@@ -80,7 +87,7 @@ std::string List::toString() {
 
 size_t List::getHash() {
     std::stringstream ss;
-    ss << _typeName << " is not hashable";
+    ss << typeName() << " is not hashable";
     throw SxRuntimeError(ss.str());
 }
 
@@ -96,6 +103,10 @@ bool List::isEqualTo(Obj* obj) {
     }
     else if (Vector* p = pVector(obj))
         return p->isEqualTo(this);
+    else if (ArgSeq* p = pArgSeq(obj))
+        return p->isEqualTo(this);
+    else if (ASeq* p = pASeq(obj))
+        return p->isEqualTo(this);
     else if (MapEntry* p = pMapEntry(obj)) {
         return count() == 2
             && rt::isEqualTo(first(), p->key())
@@ -156,7 +167,7 @@ Obj* List::nth(int i) {
                 return s->first();
     }
     std::stringstream ss;
-    ss << _typeName << " index (" << i << ") out of bounds";
+    ss << typeName() << " index (" << i << ") out of bounds";
     throw SxOutOfBoundsError(ss.str());
 }
 
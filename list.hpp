@@ -7,13 +7,18 @@
 #ifndef LIST_HPP_INCLUDED
 #define LIST_HPP_INCLUDED
 
+struct VecTrie;
+
 struct List : ISeqable, ISeq, IIndexed, ICollection, IMeta {
+    friend struct ArgSeq;       // for ArgSeq::cons()
+    friend struct ASeq;         // and ASeq::cons()
     static List* create();
     static List* create(Obj*);
     static List* create(Obj*, Obj*);
     static List* create(Obj*, Obj*, Obj*);
     static List* create(Obj*, Obj*, Obj*, Obj*);
     static List* create(vecobj_t);
+    static List* create(const VecTrie&);
     // 
     static void init();
     void setHead(Obj*);
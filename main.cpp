@@ -6,10 +6,25 @@
 
 #include "sxp.hpp"
 
+/*
+  sxp [--direct-link] [file]
+
+  --direct-link  link every non-dynamic var, core.sxp included, see
+                 Var::isLinkable()
+*/
 int main(int argc, char** argv) {
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-'; ++i) {
+        if (!strcmp(argv[i], "--direct-link"))
+            rt::directLink = true;
+        else {
+            std::cerr << "usage: sxp [--direct-link] [file]" << std::endl;
+            return 1;
+        }
+    }
     rt::init();
-    if (argc > 1)
-        rt::loadFile(argv[1]);
+    if (i < argc)
+        rt::loadFile(argv[i]);
     else
         rt::loadFile("sxpsrc/repl.sxp");
     return 0;
@@ -13,7 +13,7 @@ MapEntry* MapEntry::create(Obj* key, Obj* val) {
 MapEntry::MapEntry(Obj* key, Obj* val)
     : _key(key),
       _val(val) {
-    _typeName = "SxMapEntry";
+    _typeId = TID_MapEntry;
 }
 
 Obj* MapEntry::key() {
@@ -34,7 +34,7 @@ std::string MapEntry::toString() {
 
 size_t MapEntry::getHash() {
     std::stringstream ss;
-    ss << _typeName << " is not hashable";
+    ss << typeName() << " is not hashable";
     throw SxRuntimeError(ss.str());
 }
 
@@ -69,7 +69,7 @@ Obj* MapEntry::nth(int i) {
     else if (i == 1)
         return _val;
     std::stringstream ss;
-    ss << _typeName << " index (" << i << ") out of bounds";
+    ss << typeName() << " index (" << i << ") out of bounds";
     throw SxOutOfBoundsError(ss.str());
 }
 
@@ -28,7 +28,7 @@ Namespace* Namespace::fetch(Symbol* sym) {
     Namespace* ns = pNamespace(_namespaces->valAt(sym, NIL));
     if (!ns) {
         ns = new Namespace(sym);
-        _namespaces->assoc(sym, ns);
+        _namespaces = cpHashmap(_namespaces->assoc(sym, ns));
     }
     // std::cout << "ALL:" << rt::toString(_namespaces) << std::endl;
     return ns;
@@ -43,11 +43,16 @@ std::string Namespace::toString() {
 
 Namespace::Namespace(Symbol* name)
     : _name(name),
-      _bindings(Hashmap::create()),
-      _aliases(Hashmap::create()) {
-    for (auto e : rt::DEFAULT_IMPORTS->impl())
-        _bindings->assoc(e.first, e.second);
-    _typeName = "SxNamespace";
+      _bindings(Hashmap::create(rt::DEFAULT_IMPORTS->impl())),
+      _aliases(Hashmap::create()),
+      _meta(Hashmap::create()) {
+    _typeId = TID_Namespace;
+}
+
+// Unlike most withMeta()s, this changes the namespace. See Var::isLinkable()
+Namespace* Namespace::withMeta(Hashmap* m) {
+    _meta = m ? m : Hashmap::create();
+    return this;
 }
 
 Var* Namespace::intern(Symbol* sym) {
@@ -64,7 +69,7 @@ Var* Namespace::intern(Symbol* sym) {
         else
             warnOrFailOnReplace(sym, pVar(curVar), newVar);
     }
-    _bindings->assoc(sym, newVar);
+    _bindings = cpHashmap(_bindings->assoc(sym, newVar));
     return newVar;
 }
 
@@ -138,5 +143,5 @@ void Namespace::reference(Symbol* sym, Obj* val) {
         else
             warnOrFailOnReplace(sym, oldVal, val);
     }
-    _bindings->assoc(sym, val);
+    _bindings = cpHashmap(_bindings->assoc(sym, val));
 }
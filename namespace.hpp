@@ -11,7 +11,7 @@
   A named map where the keys are symbols and the values are vars or constant
   objects.
 */
-struct Namespace : Obj {
+struct Namespace : IMeta {
     static void init();
     static void shutdown();
     static Namespace* find(Symbol*);
@@ -24,11 +24,15 @@ struct Namespace : Obj {
     Var* findInternedVar(Symbol*);
     Obj* get(Symbol*); // return a Var or a `constant' Obj
     void refer(Namespace* src);
+    // IMeta
+    Hashmap* meta() { return _meta; }
+    Namespace* withMeta(Hashmap* m);
 protected:
     static Hashmap* _namespaces;
     Symbol* _name;
     Hashmap* _bindings;
     Hashmap* _aliases;
+    Hashmap* _meta;
     Namespace(Symbol* name);
     void warnOrFailOnReplace(Symbol* sym, Obj* curVal, Obj* newVal);
     void reference(Symbol* sym, Obj* val);
@@ -19,7 +19,13 @@ void Integer::shutdown() {
     _cache.clear();
 }
 
-Integer* Integer::fetch(long val) {
+Obj* Integer::fetch(long val) {
+    if (fitsFixnum(val))
+        return makeFixnum(val);
+    return new (PointerFreeGC) Integer(val);
+}
+
+Integer* Integer::box(long val) {
     if (val >= MIN_CACHED_INT && val <= MAX_CACHED_INT) {
         int idx = val + std::abs(MIN_CACHED_INT);
         if (Integer* obj = _cache[idx])
@@ -32,7 +38,7 @@ Integer* Integer::fetch(long val) {
 
 Integer::Integer(long val)
     : _val(val), _hash(std::hash<long>()(val)) {
-    _typeName = "SxInteger";
+    _typeId = TID_Integer;
 }
 
 long Integer::val() {
@@ -52,7 +58,7 @@ size_t Integer::getHash() {
 bool Integer::isEqualTo(Obj* obj) {
     if (this == obj)
         return true;
-    if (Integer* i = dynamic_cast<Integer*>(obj))
+    if (Integer* i = pInteger(obj))
         return _val == i->_val;
     return false;
 }
@@ -64,7 +70,7 @@ bool Integer::less(Obj* x) {
 // -------------------------------------------------------------------------
 // INumber
 
-INumber* Integer::add(INumber* y) {
+Obj* Integer::add(INumber* y) {
     if (Integer* p = pInteger(y))
         return Integer::fetch(_val + p->val());
     else if (Float* p = pFloat(y))
@@ -80,7 +86,7 @@ INumber* Integer::add(INumber* y) {
     }
 }
 
-INumber* Integer::sub(INumber* y) {
+Obj* Integer::sub(INumber* y) {
     if (Integer* p = pInteger(y))
         return Integer::fetch(_val - p->val());
     else if (Float* p = pFloat(y))
@@ -96,7 +102,7 @@ INumber* Integer::sub(INumber* y) {
     }
 }
 
-INumber* Integer::mul(INumber* y) {
+Obj* Integer::mul(INumber* y) {
     if (Integer* p = pInteger(y))
         return Integer::fetch(_val * p->val());
     else if (Float* p = pFloat(y))
@@ -107,18 +113,18 @@ INumber* Integer::mul(INumber* y) {
     }
 }
 
-INumber* Integer::div(INumber* y) {
+Obj* Integer::div(INumber* y) {
     if (y->toFloat() == 0.0)
         throw SxArithmeticError("can't divide by zero");
     if (Integer* p = pInteger(y))
         return Ratio::simplify(_val, p->val());
     else if (Float* p = pFloat(y))
         return Float::create(_val / p->val());
-    return mul(Ratio::simplify(pRatio(y)->denominator(), // inverted
-                               pRatio(y)->numerator()));
+    return mul(cpINumber(Ratio::simplify(pRatio(y)->denominator(), // inverted
+                                         pRatio(y)->numerator())));
 }
 
-INumber* Integer::neg() {
+Obj* Integer::neg() {
     return Integer::fetch(-val());
 }
 
@@ -147,7 +153,7 @@ double Float::val() {
 
 Float::Float(double val)
     : _val(val), _hash(std::hash<double>()(val)) {
-    _typeName = "SxFloat";
+    _typeId = TID_Float;
 }
 
 std::string Float::toString() {
@@ -180,26 +186,26 @@ bool Float::less(Obj* x) {
 // -------------------------------------------------------------------------
 // INumber
 
-INumber* Float::add(INumber* y) {
+Obj* Float::add(INumber* y) {
     return Float::create(_val + y->toFloat());
 }
 
-INumber* Float::sub(INumber* y) {
+Obj* Float::sub(INumber* y) {
     return Float::create(_val - y->toFloat());
 }
 
-INumber* Float::mul(INumber* y) {
+Obj* Float::mul(INumber* y) {
     return Float::create(_val * y->toFloat());
 }
 
-INumber* Float::div(INumber* y) {
+Obj* Float::div(INumber* y) {
     double yy = y->toFloat();
     if (yy == 0.0)
         throw SxArithmeticError("can't divide by zero");
     return Float::create(_val / yy);
 }
 
-INumber* Float::neg() {
+Obj* Float::neg() {
     return Float::create(-val());
 }
 
@@ -218,7 +224,7 @@ bool Float::lt(INumber* x) {
 // =========================================================================
 // Ratio
 
-INumber* Ratio::simplify(long n, long d) {
+Obj* Ratio::simplify(long n, long d) {
     if (d < 0) {
         // invert so only numerator is negative
         assert(n >= 0 && "BOTH NUM AND DEN CANNOT BE NEGATIVE");
@@ -248,7 +254,7 @@ Ratio::Ratio(long num, long den)
     assert(num != 0 && "RATIO NUMERATOR CANNOT BE 0");
     assert(den != 0 && "RATIO DENOMINATOR CANNOT BE 0");
     assert(den != 1 && "RATIO DENOMINATOR CANNOT BE 1");
-    _typeName = "SxRatio";
+    _typeId = TID_Ratio;
 }
 
 std::string Ratio::toString() {
@@ -293,7 +299,7 @@ double Ratio::toFloat() {
     return static_cast<double>(_num) / static_cast<double>(_den);
 }
 
-INumber* Ratio::add(INumber* y) {
+Obj* Ratio::add(INumber* y) {
     if (Integer* p = pInteger(y))
         return Ratio::simplify(p->val() * _den + _num, _den);
     else if (Float* p = pFloat(y))
@@ -310,9 +316,9 @@ INumber* Ratio::add(INumber* y) {
     }
 }
 
-INumber* Ratio::sub(INumber* y) {
+Obj* Ratio::sub(INumber* y) {
     if (Integer* p = pInteger(y))
-        return add(Integer::fetch(-p->val()));
+        return add(Integer::box(-p->val()));
     else if (Float* p = pFloat(y))
         return Float::create(toFloat() - p->val());
     else {
@@ -327,7 +333,7 @@ INumber* Ratio::sub(INumber* y) {
     }
 }
 
-INumber* Ratio::mul(INumber* y) {
+Obj* Ratio::mul(INumber* y) {
     if (Integer* p = pInteger(y))
         return simplify(_num * p->val(), _den);
     else if (Float* p = pFloat(y)) {
@@ -341,7 +347,7 @@ INumber* Ratio::mul(INumber* y) {
     }
 }
 
-INumber* Ratio::div(INumber* y) {
+Obj* Ratio::div(INumber* y) {
     if (y->toFloat() == 0.0)
         throw SxArithmeticError("can't divide by zero");
     else if (Float* p = pFloat(y))
@@ -369,7 +375,7 @@ INumber* Ratio::div(INumber* y) {
     }
 }
 
-INumber* Ratio::neg() {
+Obj* Ratio::neg() {
     return Ratio::simplify(-_num, _den);
 }
 
@@ -10,7 +10,8 @@
 struct Integer : INumber, ISortable {
     static void init();
     static void shutdown();
-    static Integer* fetch(long);
+    static Obj* fetch(long);     // a fixnum when it fits
+    static Integer* box(long);
     long val();
     // Obj
     std::string toString();
@@ -22,11 +23,11 @@ struct Integer : INumber, ISortable {
     // INumber
     long toInt() { return _val; }
     double toFloat() { return _val; }
-    INumber* add(INumber*);
-    INumber* sub(INumber*);
-    INumber* mul(INumber*);
-    INumber* div(INumber*);
-    INumber* neg();
+    Obj* add(INumber*);
+    Obj* sub(INumber*);
+    Obj* mul(INumber*);
+    Obj* div(INumber*);
+    Obj* neg();
     bool eq(INumber*);
     bool lt(INumber*);
 protected:
@@ -53,11 +54,11 @@ struct Float : INumber, ISortable {
     // INumber
     long toInt() { return _val; }
     double toFloat() { return _val; }
-    INumber* add(INumber*);
-    INumber* sub(INumber*);
-    INumber* mul(INumber*);
-    INumber* div(INumber*);
-    INumber* neg();
+    Obj* add(INumber*);
+    Obj* sub(INumber*);
+    Obj* mul(INumber*);
+    Obj* div(INumber*);
+    Obj* neg();
     bool eq(INumber*);
     bool lt(INumber*);
 protected:
@@ -69,7 +70,7 @@ protected:
 DEF_CASTER(Float)
 
 struct Ratio : INumber, ISortable {
-    static INumber* simplify(long, long);
+    static Obj* simplify(long, long);
     long numerator();
     long denominator();
     std::string toString();
@@ -81,11 +82,11 @@ struct Ratio : INumber, ISortable {
     // INumber
     long toInt();
     double toFloat();
-    INumber* add(INumber*);
-    INumber* sub(INumber*);
-    INumber* mul(INumber*);
-    INumber* div(INumber*);
-    INumber* neg();
+    Obj* add(INumber*);
+    Obj* sub(INumber*);
+    Obj* mul(INumber*);
+    Obj* div(INumber*);
+    Obj* neg();
     bool eq(INumber*);
     bool lt(INumber*);
 protected:
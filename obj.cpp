@@ -6,17 +6,70 @@
 
 #include "sxp.hpp"
 
+const TypeDesc TYPE_DESCS[TID_END] = {
+    {TID_Obj, "SxObj"},
+    {TID_Bool, "SxBool"},
+    {TID_Integer, "SxInteger"},
+    {TID_Float, "SxFloat"},
+    {TID_Ratio, "SxRatio"},
+    {TID_Character, "SxCharacter"},
+    {TID_String, "SxString"},
+    {TID_Keyword, "SxKeyword"},
+    {TID_Symbol, "SxSymbol"},
+    {TID_Regex, "SxRegex"},
+    {TID_List, "SxList"},
+    {TID_Vector, "SxVector"},
+    {TID_MapEntry, "SxMapEntry"},
+    {TID_Hashmap, "SxHashmap"},
+    {TID_Hashset, "SxHashset"},
+    {TID_Treemap, "SxTreemap"},
+    {TID_Treeset, "SxTreeset"},
+    {TID_LazySeq, "SxLazySeq"},
+    {TID_ArgSeq, "SxArgSeq"},
+    {TID_VectorSeq, "SxVectorSeq"},
+    {TID_StringSeq, "SxStringSeq"},
+    {TID_HamtSeq, "SxHamtSeq"},
+    {TID_Fn, "SxFn"},
+    {TID_FnMethod, "SxFnMethod"},
+    {TID_ThrowHandler, "SxThrowHandler"},
+    {TID_Closure, "SxClosure"},
+    {TID_Proc, "SxProc"},
+    {TID_CFn, "SxCFn"},
+    {TID_SysInStream, "SxSysInStream"},
+    {TID_SysOutStream, "SxSysOutStream"},
+    {TID_FStream, "SxFStream"},
+    {TID_SStream, "SxSStream"},
+    {TID_Var, "SxVar"},
+    {TID_Namespace, "SxNamespace"},
+    {TID_LocalVar, "SxObj"},    // compiler internal, never printed
+    {TID_FreeVar, "SxObj"},     // ditto
+    {TID_SxError, "SxError"},
+    {TID_SxCastError, "SxCastError"},
+    {TID_SxAny, "SxAny"},
+    {TID_SxIOError, "SxIOError"},
+    {TID_SxReaderError, "SxReaderError"},
+    {TID_SxRuntimeError, "SxRuntimeError"},
+    {TID_SxCompilerError, "SxCompilerError"},
+    {TID_SxSyntaxError, "SxSyntaxError"},
+    {TID_SxArithmeticError, "SxArithmeticError"},
+    {TID_SxOutOfBoundsError, "SxOutOfBoundsError"},
+    {TID_SxNotImplementedError, "SxNotImplementedError"},
+    {TID_SxIllegalArgumentError, "SxIllegalArgumentError"},
+    {TID_SxSortError, "SxSortError"},
+    {TID_SxRegexError, "SxRegexError"}
+};
+
 Obj* Obj::create() {
     return new (PointerFreeGC) Obj();
 }
 
 std::string Obj::typeName() const {
-    return _typeName;
+    return TYPE_DESCS[_typeId].name;
 }
 
 std::string Obj::toString() {
     std::stringstream ss;
-    ss << "#<" << _typeName << " " << this << ">"; // #<_typename address>
+    ss << "#<" << typeName() << " " << this << ">"; // #<typename address>
     return ss.str();
 }
 
@@ -32,6 +85,20 @@ Obj* Obj::copy() {
     throw SxNotImplementedError(typeName() + " is not copy-able");
 }
 
+Obj* boxImmediate(Obj* x) {
+    assert(isImmediate(x) && "BOXING A HEAP OBJECT");
+    if (isFixnum(x))
+        return Integer::box(fixnumVal(x));
+    return Character::box(immCharVal(x));
+}
+
+Obj* immediateProto(Obj* x) {
+    assert(isImmediate(x) && "BOXING A HEAP OBJECT");
+    if (isFixnum(x))
+        return Integer::box(0);
+    return Character::box(0);
+}
+
 // Has to be implemented here because xface.hpp is included after obj.hpp
 bool ObjLessFntr::operator()(Obj* o1, Obj* o2) const {
     if (!o1) {
@@ -41,6 +108,8 @@ bool ObjLessFntr::operator()(Obj* o1, Obj* o2) const {
     }
     else if (!o2)
         return false;           // o2 > nil
+    if (isFixnum(o1) && isFixnum(o2))
+        return fixnumVal(o1) < fixnumVal(o2);
     return cpISortable(o1)->less(cpISortable(o2)); // o1 < o2 ?
 }
 
@@ -7,16 +7,189 @@
 #ifndef OBJ_HPP_INCLUDED
 #define OBJ_HPP_INCLUDED
 
+struct Obj;
+
+/*
+  Immediates. Heap objects are at least 8 byte aligned so the low 3 bits of
+  a pointer to one are always zero. Integers that fit in 63 bits and
+  characters are encoded directly in the Obj* word instead and are never
+  allocated:
+
+    vvvv...vvv1  fixnum, a signed integer in the upper 63 bits
+    cccc...c010  character, the code point in the upper bits
+
+  nil is still nullptr and true/false are still the rt::T/rt::F singletons,
+  both already compared by word. An immediate must never be dereferenced.
+  The casters below box one on demand (see boxImmediate()), and the rt::
+  functions handle them directly.
+*/
+constexpr long FIXNUM_MIN = -(1L << 62);
+constexpr long FIXNUM_MAX = (1L << 62) - 1;
+
+inline bool isImmediate(const Obj* x) {
+    return reinterpret_cast<uintptr_t>(x) & 7;
+}
+inline bool isFixnum(const Obj* x) {
+    return reinterpret_cast<uintptr_t>(x) & 1;
+}
+inline bool isImmChar(const Obj* x) {
+    return (reinterpret_cast<uintptr_t>(x) & 7) == 2;
+}
+inline bool fitsFixnum(long v) {
+    return v >= FIXNUM_MIN && v <= FIXNUM_MAX;
+}
+inline Obj* makeFixnum(long v) {
+    return reinterpret_cast<Obj*>(static_cast<uintptr_t>(v) << 1 | 1);
+}
+inline long fixnumVal(const Obj* x) {
+    return reinterpret_cast<intptr_t>(x) >> 1; // arithmetic shift
+}
+inline Obj* makeImmChar(int c) {
+    return reinterpret_cast<Obj*>(static_cast<uintptr_t>(c) << 3 | 2);
+}
+inline int immCharVal(const Obj* x) {
+    return reinterpret_cast<intptr_t>(x) >> 3;
+}
+
+// Return a heap Integer or Character with the same value as the immediate x.
+Obj* boxImmediate(Obj* x);
+// Return a shared box of the same type as the immediate x, used by the
+// casters to test the type without allocating.
+Obj* immediateProto(Obj* x);
+
+// Immediate aware, defined in rt.cpp
+namespace rt {
+std::string typeName(Obj*);
+std::string toString(Obj*);
+size_t getHash(Obj*);
+bool isEqualTo(Obj*, Obj*);
+}
+
+/*
+  Type tags. Every concrete class sets its TypeID in its constructor and
+  every interface (plus the Fn and SxError families, which have subclasses)
+  ORs its IFace bit into the object in its constructor, so a type test is a
+  compare or a mask instead of a dynamic_cast through the virtual bases.
+  Everything else about a type lives once in its TypeDesc, not per instance.
+*/
+enum TypeID : uint16_t {
+    TID_Obj,
+    TID_Bool,
+    TID_Integer,
+    TID_Float,
+    TID_Ratio,
+    TID_Character,
+    TID_String,
+    TID_Keyword,
+    TID_Symbol,
+    TID_Regex,
+    TID_List,
+    TID_Vector,
+    TID_MapEntry,
+    TID_Hashmap,
+    TID_Hashset,
+    TID_Treemap,
+    TID_Treeset,
+    TID_LazySeq,
+    TID_ArgSeq,
+    TID_VectorSeq,
+    TID_StringSeq,
+    TID_HamtSeq,
+    TID_Fn,
+    TID_FnMethod,
+    TID_ThrowHandler,
+    TID_Closure,
+    TID_Proc,
+    TID_CFn,
+    TID_SysInStream,
+    TID_SysOutStream,
+    TID_FStream,
+    TID_SStream,
+    TID_Var,
+    TID_Namespace,
+    TID_LocalVar,               // compiler.cpp
+    TID_FreeVar,                // ditto
+    TID_SxError,
+    TID_SxCastError,
+    TID_SxAny,
+    TID_SxIOError,
+    TID_SxReaderError,
+    TID_SxRuntimeError,
+    TID_SxCompilerError,
+    TID_SxSyntaxError,
+    TID_SxArithmeticError,
+    TID_SxOutOfBoundsError,
+    TID_SxNotImplementedError,
+    TID_SxIllegalArgumentError,
+    TID_SxSortError,
+    TID_SxRegexError,
+    TID_END
+};
+
+struct TypeDesc {
+    TypeID id;
+    const char* name;           // what (typename x) returns
+};
+
+extern const TypeDesc TYPE_DESCS[TID_END]; // indexed by TypeID, see obj.cpp
+
+enum IFace : uint32_t {
+    IF_IMeta        = 1 << 0,
+    IF_ISeq         = 1 << 1,
+    IF_ISeqable     = 1 << 2,
+    IF_INumber      = 1 << 3,
+    IF_IIndexed     = 1 << 4,
+    IF_ICollection  = 1 << 5,
+    IF_IAssociative = 1 << 6,
+    IF_ISortable    = 1 << 7,
+    IF_IStream      = 1 << 8,
+    IF_IInStream    = 1 << 9,
+    IF_IOutStream   = 1 << 10,
+    IF_ISet         = 1 << 11,
+    IF_Fn           = 1 << 12,  // Fn and its subclasses
+    IF_SxError      = 1 << 13,  // SxError and its subclasses
+    IF_ASeq         = 1 << 14   // ASeq and its subclasses
+};
+
+#ifdef SXP_DYNAMIC_CAST
+
+// The old casters, kept to measure against (see sxpsrc/bench-cast.sxp)
+#define DEF_CASTER_IMPL(t, test)                                        \
+    static inline t* p##t(Obj* obj) {                                   \
+        if (isImmediate(obj))                                           \
+            return dynamic_cast<t*>(immediateProto(obj))                \
+                ? dynamic_cast<t*>(boxImmediate(obj)) : nullptr;        \
+        return dynamic_cast<t*>(obj);                                   \
+    }
+
+#else
+
+#define DEF_CASTER_IMPL(t, test)                                        \
+    static inline bool is##t(Obj* x) { return test; }                   \
+    static inline t* p##t(Obj* obj) {                                   \
+        if (isImmediate(obj))                                           \
+            return is##t(immediateProto(obj))                           \
+                ? objCast<t>(boxImmediate(obj)) : nullptr;              \
+        return obj && is##t(obj) ? objCast<t>(obj) : nullptr;           \
+    }
+
+#endif
+
 // If t = Foo, emit:
 // static inline Foo* pFoo(Obj*) {...}
 // static inline Foo* cpFoo(Obj*) {...}
+// DEF_CASTER is for a class without subclasses and tests the TypeID,
+// DEF_XFACE_CASTER is for an interface or family and tests the IFace bit.
 #define DEF_CASTER(t)                                                   \
-    static inline t* p##t(Obj* obj) {                                   \
-        return dynamic_cast<t*>(obj);                                   \
-    }                                                                   \
+    DEF_CASTER_IMPL(t, x->typeId() == TID_##t)                          \
+    DEF_CHECKED_CASTER(t)
+#define DEF_XFACE_CASTER(t)                                             \
+    DEF_CASTER_IMPL(t, x->ifaces() & IF_##t)                            \
+    DEF_CHECKED_CASTER(t)
+#define DEF_CHECKED_CASTER(t)                                           \
     static inline t* cp##t(Obj* obj) {                                  \
-        if (t* p = dynamic_cast<t*>(obj)) return p;                     \
-        throw SxCastError(obj ? obj->typeName() : "nil", #t);           \
+        if (t* p = p##t(obj)) return p;                                 \
+        throw SxCastError(obj ? rt::typeName(obj) : "nil", #t);         \
     }
 
 /*
@@ -29,56 +202,46 @@ struct Obj : public gc {
     virtual size_t getHash();
     virtual bool isEqualTo(Obj*);
     virtual Obj* copy();
+    TypeID typeId() const { return _typeId; }
+    uint32_t ifaces() const { return _ifaces; }
 protected:    
-    std::string _typeName;
-    Obj() : _typeName("SxObj") {}
+    TypeID _typeId;
+    uint32_t _ifaces;
+    Obj() : _typeId(TID_Obj), _ifaces(0) {}
 };
 
+/*
+  Convert obj, already known to be a T, to a T*. T may be a virtual base so
+  the pointer adjustment depends on obj's concrete type. It is found once per
+  (T, TypeID) pair with dynamic_cast and remembered, with the low bit set so
+  a zero adjustment can be told from an empty slot.
+*/
+template <typename T>
+inline T* objCast(Obj* obj) {
+    static intptr_t adjust[TID_END];
+    intptr_t& a = adjust[obj->typeId()];
+    if (!a) {
+        T* p = dynamic_cast<T*>(obj);
+        assert(p && "TYPE TAG DISAGREES WITH DYNAMIC TYPE");
+        a = (reinterpret_cast<intptr_t>(p)
+             - reinterpret_cast<intptr_t>(obj)) * 2 | 1;
+    }
+    return reinterpret_cast<T*>(reinterpret_cast<char*>(obj) + (a >> 1));
+}
+
 #define NIL nullptr
 
 // std::equal predicate used by Vector::isEqualTo()
 inline bool objEqual(Obj* o1, Obj* o2) {
-    if (!o1)
-        return !o2;
-    return o1->isEqualTo(o2);
+    return rt::isEqualTo(o1, o2);
 }
 
-struct ObjEqFntr {
-    size_t operator()(Obj* o1, Obj* o2) const {
-        if (o1 == NIL)
-            return o2 == NIL;
-        return o1->isEqualTo(o2);
-    }
-};
-
-struct ObjHashFntr {
-    size_t operator()(Obj* obj) const {
-        if (obj == NIL)
-            return 0;
-        return obj->getHash();
-    }
-};
-
 struct ObjLessFntr { bool operator()(Obj*, Obj*) const; };
 
 // sxp vector impl
 typedef std::vector<Obj*,
                     gc_allocator<Obj*>> vecobj_t;
 
-// sxp hashmap impl
-typedef std::unordered_map<Obj*,
-                           Obj*,
-                           ObjHashFntr,
-                           ObjEqFntr,
-                           gc_allocator<std::pair<Obj* const,
-                                                  Obj*>>> hashmap_t;
-
-// sxp hashset impl
-typedef std::unordered_set<Obj*,
-                           ObjHashFntr,
-                           ObjEqFntr,
-                           gc_allocator<Obj*>> hashset_t;
-
 // sxp treemap impl
 typedef std::map<Obj*,
                  Obj*,
@@ -12,7 +12,7 @@ Proc* Proc::create(const std::string& name) {
 
 Proc::Proc(const std::string& name)
     : Fn(name) {
-    _typeName = "SxProc";
+    _typeId = TID_Proc;
 }
 
 std::string Proc::toString() {
@@ -79,6 +79,10 @@ static void initNumberProcs() {
     proc->addMethod(false, 1, vasm::LT_1);
     proc->addMethod(false, 2, vasm::LT_2);
     proc->addMethod(true, 2, vasm::LT_2N);
+    MAKPRC("inc", "[x]", "Return x + 1");
+    proc->addMethod(false, 1, vasm::INC_1);
+    MAKPRC("dec", "[x]", "Return x - 1");
+    proc->addMethod(false, 1, vasm::DEC_1);
 }
 
 static void initPredicateProcs() {
@@ -236,6 +240,15 @@ static void initVMProcs() {
     MAKPRC("vm-stack", "[]", "Print the contents of the stack to the current"
            " value of *out*");
     proc->addMethod(false, 0, vasm::VM_STACK_0);
+    MAKPRC("vm-stats", "[]", "Toggle collection of VM statistics: the number"
+           " of instructions executed and a histogram of the opcodes.");
+    proc->addMethod(false, 0, vasm::VM_STATS_0);
+    MAKPRC("vm-stats-print", "[]", "Print the VM statistics collected so far"
+           " to the current value of *out*");
+    proc->addMethod(false, 0, vasm::VM_STATS_PRINT_0);
+    MAKPRC("gc-bytes", "[]", "Return the total number of bytes allocated"
+           " by the garbage collector so far.");
+    proc->addMethod(false, 0, vasm::GC_BYTES_0);
 }
 
 static void initErrorProcs() {
@@ -352,8 +365,9 @@ void Proc::initProcs() {
            " supplied.");
     proc->addMethod(false, 2, vasm::GET_2);
     proc->addMethod(false, 3, vasm::GET_3);
-    MAKPRC("assoc", "[map key val & keysvals]", "Adds the key/val pair to"
-           " the map, in place. If map is nil, a new map is created and"
+    MAKPRC("assoc", "[map key val & keysvals]", "Returns map with the key/val"
+           " pairs added. If map is a vector, the keys are indices, one"
+           " past the end adds val. If map is nil, a new map is created and"
            " returned.");
     proc->addMethod(true, 3, vasm::ASSOC_3N);
     MAKPRC("dissoc", "[map & keys]", "Returns map with all entries at keys"
@@ -369,6 +383,10 @@ void Proc::initProcs() {
     MAKPRC("macroexpand-1", "[form]", "Expand form if a macro, else"
            " return x.");
     proc->addMethod(false, 1, vasm::MACROEXPAND_1_1);
+    MAKPRC("ir", "[form]", "Return form as the compiler lowers it before"
+           " emitting bytecode: fully macroexpanded, with calls to :inline"
+           " fns expanded.");
+    proc->addMethod(false, 1, vasm::IR_1);
     MAKPRC("contains?", "[coll key]",
            "Return true if coll contains key. If key is a number and coll is"
            " indexable, return true if key is a valid index into coll.");
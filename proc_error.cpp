@@ -6,25 +6,25 @@
 
 // ... proc]
 // ... proc e]
-case vasm::ERROR_0: {
+INSTR(ERROR_0) {
     ppush(new (PointerFreeGC) SxError());
     break;
 }
 // ... proc string]
 // ... proc string e]
-case vasm::ERROR_1: {
+INSTR(ERROR_1) {
     ppush(new (PointerFreeGC) SxError(cpString(ppeek())->val()));
     break;
 }
 // ... proc type string]
 // ... proc type string e]
-case vasm::ERROR_2: {
+INSTR(ERROR_2) {
     ppush(cpSxError(ppeek(1))->clone(cpString(ppeek())->val()));
     break;
 }
 // ... proc e]
 // ... proc e string]
-case vasm::ERR_MSG_1: {
+INSTR(ERR_MSG_1) {
     ppush(String::fetch(cpSxError(ppeek())->what()));
     break;
 }
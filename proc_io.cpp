@@ -6,14 +6,14 @@
 
 // ... proc string]
 // ... proc string nil]
-case vasm::LOAD_1: {
+INSTR(LOAD_1) {
     rt::loadFile(cpString(ppeek())->val());
     ppush(NIL);
     break;
 }
 // ... proc file-name list-or-nil]
 // ... proc file-name list-or-nil fstream]
-case vasm::FSTREAM_1N: {
+INSTR(FSTREAM_1N) {
     ISeq* s = pISeq(ppeek());
     if (s == NIL)
         ppush(FStream::create(cpString(ppeek(1))->val(), std::ios_base::in));
@@ -27,13 +27,13 @@ case vasm::FSTREAM_1N: {
 }
 // ... proc]
 // ... proc sstream]
-case vasm::SSTREAM_0: {
+INSTR(SSTREAM_0) {
     ppush(SStream::create(""));
     break;
 }
 // ... proc init-str list-or-nil]
 // ... proc init-str list-or-nil sstream]
-case vasm::SSTREAM_1N: {
+INSTR(SSTREAM_1N) {
     ISeq* modes = pISeq(ppeek());
     if (modes == NIL)
         ppush(SStream::create(cpString(ppeek(1))->val()));
@@ -47,27 +47,27 @@ case vasm::SSTREAM_1N: {
 }
 // ... proc]
 // ... proc result]
-case vasm::READ_0: {
+INSTR(READ_0) {
     IInStream* s = cpIInStream(rt::currentIN());
     ppush(reader::readOne(s, true, NIL));
     break;
 }
 // ... proc stream]
 // ... proc stream result]
-case vasm::READ_1: {
+INSTR(READ_1) {
     ppush(reader::readOne(cpIInStream(ppeek()), true, NIL));
     break;
 }
 // ... proc stream bool obj]
 // ... proc stream bool obj result]
-case vasm::READ_3: {
+INSTR(READ_3) {
     ppush(reader::readOne(cpIInStream(ppeek(2)), rt::toBool(ppeek(1)),
                           ppeek()));
     break;
 }
 // ... proc stream]
 // ... proc stream char]
-case vasm::READ_CHAR_1: {
+INSTR(READ_CHAR_1) {
     IInStream* s = cpIInStream(ppeek());
     int c = s->get();
     if (s->eof())
@@ -77,10 +77,10 @@ case vasm::READ_CHAR_1: {
 }
 // ... proc list-or-nil]
 // ... proc list_or-nil nil]
-case vasm::PR_0N: {
-    for (ISeq* s=rt::seq(ppeek()); s; s=s->next()) {
-        cpIOutStream(rt::currentOUT())->print(s->first());
-        if (s->next())
+INSTR(PR_0N) {
+    for (SeqIter i(ppeek()); i; ) {
+        cpIOutStream(rt::currentOUT())->print(*i);
+        if (++i)
             cpIOutStream(rt::currentOUT())->put(' ');
     }
     ppush(NIL);
@@ -88,7 +88,7 @@ case vasm::PR_0N: {
 }
 // ... proc]
 // ... proc nil]
-case vasm::NEWLINE_0: {
+INSTR(NEWLINE_0) {
     IOutStream* s = cpIOutStream(rt::currentOUT());
     s->put('\n');
     if (rt::flushOnNewline())
@@ -98,14 +98,14 @@ case vasm::NEWLINE_0: {
 }
 // ... proc stream
 // ... proc stream nil
-case vasm::FCLOSE_1: {
+INSTR(FCLOSE_1) {
     cpFStream(ppeek())->close();
     ppush(NIL);
     break;
 }
 // ... proc file-name
 // ... proc file-name text
-case vasm::SLURP_1: {
+INSTR(SLURP_1) {
     std::string fname = cpString(ppeek())->val();
     std::ifstream s(fname);
     if (!s.is_open())
@@ -118,7 +118,7 @@ case vasm::SLURP_1: {
 }
 // ... proc]
 // ... proc string]
-case vasm::READ_LINE_0: {
+INSTR(READ_LINE_0) {
     IInStream* s = cpIInStream(rt::currentIN());
     if (s->eof())
         ppush(NIL);
@@ -8,26 +8,26 @@
 
 // ... proc ns]
 // ... proc ns hashmap]
-case vasm::NS_MAP_1: {
+INSTR(NS_MAP_1) {
     ppush(cpNamespace(ppeek())->bindings());
     break;
 }
 // ... proc ns]
 // ... proc ns sym]
-case vasm::NS_NAME_1: {
+INSTR(NS_NAME_1) {
     ppush(cpNamespace(ppeek())->name());
     break;
 }
 // ... proc sym]
 // ... proc sym ns]
-case vasm::IN_NS_1: {
+INSTR(IN_NS_1) {
     Namespace* ns = Namespace::fetch(cpSymbol(ppeek(0)));
     ppush(rt::currentNS(ns));
     break;
 }
 // ... proc sym]
 // ... proc sym nil]
-case vasm::REFER_1: {
+INSTR(REFER_1) {
     Symbol* sym = cpSymbol(ppeek());
     if (Namespace* ns = Namespace::find(sym)) {
         rt::currentNS()->refer(ns);
@@ -40,22 +40,22 @@ case vasm::REFER_1: {
 }
 // ... proc sym]
 // ... proc sym ns-or-nil]
-case vasm::FIND_NS_1: {
+INSTR(FIND_NS_1) {
     ppush(Namespace::find(cpSymbol(ppeek())));
     break;
 }
 // ... proc sym]
 // ... proc sym map]
-case vasm::NS_PUBLICS_1: {
+INSTR(NS_PUBLICS_1) {
     Symbol* sym = cpSymbol(ppeek());
     if (Namespace* ns = Namespace::find(sym)) {
-        Hashmap* m = Hashmap::create();
+        Hashmap* m = Hashmap::create()->transient();
         for (auto e : ns->bindings()->impl()) {
             if (Var* v = pVar(e.second))
                 if (v->ns() == ns && v->isPublic())
                     m->assoc(e.first, e.second);
         }
-        ppush(m);
+        ppush(m->persistent());
     }
     else
         throw SxRuntimeError("namespace (" + sym->toString()
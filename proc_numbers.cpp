@@ -9,141 +9,139 @@
 
 // ... proc number]
 // ... proc number integer]
-case vasm::INT_1: {
-    ppush(Integer::fetch(cpINumber(ppeek(0))->toInt()));
+INSTR(INT_1) {
+    ppush(Integer::fetch(rt::toInt(ppeek(0))));
     break;
 }
 // ... proc number]
 // ... proc number float]
-case vasm::FLOAT_1: {
+INSTR(FLOAT_1) {
     ppush(Float::create(cpINumber(ppeek(0))->toFloat()));
     break;
 }
 
 // ... proc]
 // ... proc 0]
-case vasm::ADD_0: {
+INSTR(ADD_0) {
     ppush(Integer::fetch(0));
     break;
 }
 // ... proc x]
 // ... proc x x]
-case vasm::ADD_1: {
-    ppush(cpINumber(ppeek())); // throw if not a number, else dup it
+INSTR(ADD_1) {
+    cpINumber(ppeek());         // throw if not a number
+    ppush(ppeek());             // else dup it
     break;
 }
 // ... proc x y]
 // ... proc x y sum]
-case vasm::ADD_2: {
-    ppush(cpINumber(ppeek(1))->add(cpINumber(ppeek())));
+INSTR(ADD_2) {
+    ppush(rt::add(ppeek(1), ppeek()));
     break;
 }
 // ... proc x y list-or-nil]
 // ... proc x y list-or-nil sum]
-case vasm::ADD_2N: {
-    INumber* x = cpINumber(ppeek(2)), *y = cpINumber(ppeek(1));
-    x = x->add(y);
-    for (ISeq* s=rt::seq(ppeek()); s; s=s->next())
-        x = x->add(cpINumber(s->first()));
+INSTR(ADD_2N) {
+    Obj* x = rt::add(ppeek(2), ppeek(1));
+    for (SeqIter i(ppeek()); i; ++i)
+        x = rt::add(x, *i);
     ppush(x);
     break;
 }
 // ... proc x]
 // ... proc x -x]
-case vasm::SUB_1: {
-    ppush(cpINumber(ppeek())->neg());
+INSTR(SUB_1) {
+    ppush(rt::neg(ppeek()));
     break;
 }
 // ... proc x y]
 // ... proc x y dif]
-case vasm::SUB_2: {
-    ppush(cpINumber(ppeek(1))->sub(cpINumber(ppeek())));
+INSTR(SUB_2) {
+    ppush(rt::sub(ppeek(1), ppeek()));
     break;
 }
 // ... proc x y list-or-nil]
 // ... proc x y list-or-nil dif]
-case vasm::SUB_2N: {
-    INumber* x = cpINumber(ppeek(2)), *y = cpINumber(ppeek(1));
-    x = x->sub(y);
-    for (ISeq* s=rt::seq(ppeek()); s; s=s->next())
-        x = x->sub(cpINumber(s->first()));
+INSTR(SUB_2N) {
+    Obj* x = rt::sub(ppeek(2), ppeek(1));
+    for (SeqIter i(ppeek()); i; ++i)
+        x = rt::sub(x, *i);
     ppush(x);
     break;
 }
 // ... proc]
 // ... proc 0]
-case vasm::MUL_0: {
+INSTR(MUL_0) {
     ppush(Integer::fetch(1));
     break;
 }
 // ... proc x]
 // ... proc x x]
-case vasm::MUL_1: {
-    ppush(cpINumber(ppeek())); // throw if not a number, else dup it
+INSTR(MUL_1) {
+    cpINumber(ppeek());         // throw if not a number
+    ppush(ppeek());             // else dup it
     break;
 }
 // ... proc x y]
 // ... proc x y prod]
-case vasm::MUL_2: {
-    ppush(cpINumber(ppeek(1))->mul(cpINumber(ppeek())));
+INSTR(MUL_2) {
+    ppush(rt::mul(ppeek(1), ppeek()));
     break;
 }
 // ... proc x y list-or-nil]
 // ... proc x y list-or-nil prod]
-case vasm::MUL_2N: {
-    INumber* x = cpINumber(ppeek(2)), *y = cpINumber(ppeek(1));
-    x = x->mul(y);
-    for (ISeq* s=rt::seq(ppeek()); s; s=s->next())
-        x = x->mul(cpINumber(s->first()));
+INSTR(MUL_2N) {
+    Obj* x = rt::mul(ppeek(2), ppeek(1));
+    for (SeqIter i(ppeek()); i; ++i)
+        x = rt::mul(x, *i);
     ppush(x);
     break;
 }
 // ... proc x]
 // ... proc x quot]
-case vasm::DIV_1: {
-    ppush(rt::INT_ONE->div(cpINumber(ppeek())));
+INSTR(DIV_1) {
+    ppush(rt::div(rt::INT_ONE, ppeek()));
     break;
 }
 // ... proc x y]
 // ... proc x y quot]
-case vasm::DIV_2: {
-    ppush(cpINumber(ppeek(1))->div(cpINumber(ppeek())));
+INSTR(DIV_2) {
+    ppush(rt::div(ppeek(1), ppeek()));
     break;
 }
 // ... proc x y list-or-nil]
 // ... proc x y list-or-nil sum]
-case vasm::DIV_2N: {
-    INumber* x = cpINumber(ppeek(2)), *y = cpINumber(ppeek(1));
-    x = x->div(y);
-    for (ISeq* s=rt::seq(ppeek()); s; s=s->next())
-        x = x->div(cpINumber(s->first()));
+INSTR(DIV_2N) {
+    Obj* x = rt::div(ppeek(2), ppeek(1));
+    for (SeqIter i(ppeek()); i; ++i)
+        x = rt::div(x, *i);
     ppush(x);
     break;
 }
 // ... proc x]
 // ... proc x true]
-case vasm::EQEQ_1: {
+INSTR(EQEQ_1) {
     ppush(rt::T);
     break;
 }
 // ... proc x y]
 // ... proc x y bool]
-case vasm::EQEQ_2: {
-    ppush(cpINumber(ppeek(1))->eq(cpINumber(ppeek())) ? rt::T : rt::F);
+INSTR(EQEQ_2) {
+    ppush(rt::numEq(ppeek(1), ppeek()) ? rt::T : rt::F);
     break;
 }
 // ... proc x y list-or-nil]
 // ... proc x y list-or-nil bool]
-case vasm::EQEQ_2N: {
-    INumber* x = cpINumber(ppeek(2)), *y = cpINumber(ppeek(1));
-    if (!x->eq(y)) {
+INSTR(EQEQ_2N) {
+    Obj* x = ppeek(2), *y = ppeek(1);
+    if (!rt::numEq(x, y)) {
         ppush(rt::F);
         goto EQEQ_FAIL;
     }
     x = y;
-    for (ISeq* s=rt::seq(ppeek()); s; s=s->next()) {
-        y = cpINumber(s->first());
-        if (!x->eq(y)) {
+    for (SeqIter i(ppeek()); i; ++i) {
+        y = *i;
+        if (!rt::numEq(x, y)) {
             ppush(rt::F);
             goto EQEQ_FAIL;
         }
@@ -155,28 +153,28 @@ case vasm::EQEQ_2N: {
 }
 // ... proc x]
 // ... proc x true]
-case vasm::LT_1: {
+INSTR(LT_1) {
     ppush(rt::T);
     break;
 }
 // ... proc x y]
 // ... proc x y bool]
-case vasm::LT_2: {
-    ppush(cpINumber(ppeek(1))->lt(cpINumber(ppeek())) ? rt::T : rt::F);
+INSTR(LT_2) {
+    ppush(rt::lt(ppeek(1), ppeek()) ? rt::T : rt::F);
     break;
 }
 // ... proc x y list-or-nil]
 // ... proc x y list-or-nil bool]
-case vasm::LT_2N: {
-    INumber* x = cpINumber(ppeek(2)), *y = cpINumber(ppeek(1));
-    if (!x->lt(y)) {
+INSTR(LT_2N) {
+    Obj* x = ppeek(2), *y = ppeek(1);
+    if (!rt::lt(x, y)) {
         ppush(rt::F);
         goto LT_FAIL;
     }
     x = y;
-    for (ISeq* s=rt::seq(ppeek()); s; s=s->next()) {
-        y = cpINumber(s->first());
-        if (!x->lt(y)) {
+    for (SeqIter i(ppeek()); i; ++i) {
+        y = *i;
+        if (!rt::lt(x, y)) {
             ppush(rt::F);
             goto LT_FAIL;
         }
@@ -186,4 +184,15 @@ case vasm::LT_2N: {
  LT_FAIL:
     break;
 }
-
+// ... proc x]
+// ... proc x x+1]
+INSTR(INC_1) {
+    ppush(rt::add(ppeek(), makeFixnum(1)));
+    break;
+}
+// ... proc x]
+// ... proc x x-1]
+INSTR(DEC_1) {
+    ppush(rt::sub(ppeek(), makeFixnum(1)));
+    break;
+}
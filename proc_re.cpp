@@ -6,15 +6,15 @@
 
 // ... proc re str]
 // ... proc re str result]
-case vasm::RE_MATCH_2: {
+INSTR(RE_MATCH_2) {
     Regex* re = cpRegex(ppeek(1));
     String* s = cpString(ppeek());
     std::smatch cm;
     if (std::regex_match(s->val(), cm, re->re())) {
-        Vector* v = Vector::create();
+        Vector* v = Vector::create()->transient();
         for (size_t i=0; i<cm.size(); ++i)
             v->conj(String::fetch(cm[i]));
-        ppush(v);
+        ppush(v->persistent());
     }
     else
         ppush(NIL);
@@ -22,7 +22,7 @@ case vasm::RE_MATCH_2: {
 }
 // ... proc re str int]
 // ... proc re str int result]
-case vasm::RE_MATCH_3: {
+INSTR(RE_MATCH_3) {
     const std::regex& re = cpRegex(ppeek(2))->re();
     const std::string& str = cpString(ppeek(1))->val();
     int i = cpInteger(ppeek())->val();
@@ -34,10 +34,10 @@ case vasm::RE_MATCH_3: {
     std::smatch cm;
     const std::string& subs = str.substr(i);
     if (std::regex_match(subs, cm, re)) {
-        Vector* v = Vector::create();
+        Vector* v = Vector::create()->transient();
         for (size_t i=0; i<cm.size(); ++i)
             v->conj(String::fetch(cm[i]));
-        ppush(v);
+        ppush(v->persistent());
     }
     else
         ppush(NIL);
@@ -45,7 +45,7 @@ case vasm::RE_MATCH_3: {
 }
 // ... proc re str int int]
 // ... proc re str int int result]
-case vasm::RE_MATCH_4: {
+INSTR(RE_MATCH_4) {
     const std::regex& re = cpRegex(ppeek(3))->re();
     const std::string& str = cpString(ppeek(2))->val();
     int i = cpInteger(ppeek(1))->val();
@@ -68,10 +68,10 @@ case vasm::RE_MATCH_4: {
     std::smatch cm;
     std::string subs = str.substr(i, j-i);
     if (std::regex_match(subs, cm, re)) {
-        Vector* v = Vector::create();
+        Vector* v = Vector::create()->transient();
         for (size_t i=0; i<cm.size(); ++i)
             v->conj(String::fetch(cm[i]));
-        ppush(v);
+        ppush(v->persistent());
     }
     else
         ppush(NIL);
@@ -79,7 +79,7 @@ case vasm::RE_MATCH_4: {
 }
 // ... re]
 // ... re str]
-case vasm::RE_PATTERN_1: {
+INSTR(RE_PATTERN_1) {
     ppush(String::fetch(cpRegex(ppeek())->pat()));
     break;
 }
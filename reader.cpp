@@ -61,7 +61,7 @@ static bool isWhitespace(int c) {
     return isspace(c) || ',' == c;
 }
 
-static INumber* matchNumber(const std::string& s) {
+static Obj* matchNumber(const std::string& s) {
     char* p;
     errno = 0;
     long lx = std::strtol(s.c_str(), &p, 0);
@@ -104,8 +104,8 @@ static INumber* matchNumber(const std::string& s) {
     return nullptr;
 }
 
-// literal integer or float => INumber
-static INumber* readNumber(IInStream* stream, int c) {
+// literal integer or float => number
+static Obj* readNumber(IInStream* stream, int c) {
     std::string buf;
     buf += c;
     while (true) {
@@ -116,7 +116,7 @@ static INumber* readNumber(IInStream* stream, int c) {
         }
         buf += c;
     }
-    INumber* num = matchNumber(buf);
+    Obj* num = matchNumber(buf);
     if (!num)
         throw SxReaderError("invalid number: " + buf);
     return num;
@@ -472,7 +472,7 @@ static Obj* readFn(IInStream* stream, int c) {
     argMap.clear();
     stream->unget();            // push the ( back
     Obj* form = read(stream, true, NIL);
-    Vector* fnArgs = Vector::create();
+    Vector* fnArgs = Vector::create()->transient();
     auto itr = argMap.rbegin();
     /*
       If the form request args %2 and %5, the resulting arg vector must fill
@@ -495,7 +495,7 @@ static Obj* readFn(IInStream* stream, int c) {
     if (itr3 != argMap.end())
         fnArgs->conj(rt::SYM_AMP)->conj(itr3->second);
     inReadFn = false;
-    return List::create(rt::SYM_FN, fnArgs, form);
+    return List::create(rt::SYM_FN, fnArgs->persistent(), form);
 }
 
 // =========================================================================
@@ -564,10 +564,10 @@ static bool isUnquoteSplicing(Obj* form) {
 // {a b, c d} => [a b c d]
 // {}         => []
 static Vector* flattenMap(Hashmap* m) {
-    Vector* v = Vector::create();
+    Vector* v = Vector::create()->transient();
     for (const auto& e : m->impl())
         v->conj(e.first)->conj(e.second);
-    return v;
+    return v->persistent();
 }
 
 static Obj* syntaxQuote(Obj*, Hashmap*);
@@ -576,7 +576,7 @@ static Obj* syntaxQuote(Obj*, Hashmap*);
 // ()                => nil
 // nil               => nil
 static ISeq* seqExpandList(ISeq* s, Hashmap* m) {
-    Vector* ret = Vector::create();
+    Vector* ret = Vector::create()->transient();
     for (; s; s=s->next()) {
         Obj* item = s->first();
         if (isUnquote(item))
@@ -588,7 +588,7 @@ static ISeq* seqExpandList(ISeq* s, Hashmap* m) {
         else
             ret->conj(List::create(rt::SYM_LIST, syntaxQuote(item, m)));
     }
-    return ret->seq();
+    return ret->isEmpty() ? NIL : List::create(ret->impl());
 }
 
 static Obj* syntaxQuote(Obj* obj, Hashmap* m) {
@@ -678,7 +678,7 @@ static Obj* syntaxQuote(Obj* obj, Hashmap* m) {
 // `form => result
 static Obj* readSyntaxQuote(IInStream* stream, int c) {
     (void)c;
-    Hashmap* gensyms = Hashmap::create();
+    Hashmap* gensyms = Hashmap::create()->transient();
     Obj* form = read(stream, true);
     Obj* ret = syntaxQuote(form, gensyms);
     gensyms = nullptr;                   // gc
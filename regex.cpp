@@ -20,7 +20,7 @@ Regex* Regex::create(const std::string& pattern,
 Regex::Regex(const std::regex& re, const std::string& pattern)
     : _re(re),
       _pat(pattern) {
-    _typeName = "SxRegex";
+    _typeId = TID_Regex;
 }
 
 std::string Regex::toString() {
@@ -9,6 +9,8 @@
 namespace rt {
 
 bool vmTrace;            // used every VM instance
+bool vmStats;            // collect VM::stats(), see (vm-stats)
+bool directLink = false; // link every var, see Var::isLinkable()
 
 Bool* T = nullptr;
 Bool* F = nullptr;
@@ -21,8 +23,8 @@ SysOutStream* SYS_ERR = nullptr;
 
 Obj* UNBOUND = nullptr;
 Obj* SENTINEL = nullptr;
-INumber* INT_ZERO = nullptr;
-INumber* INT_ONE = nullptr;
+Obj* INT_ZERO = nullptr;
+Obj* INT_ONE = nullptr;
 
 Symbol* SYM_VAR = nullptr;
 Symbol* SYM_UNQUOTE = nullptr;
@@ -58,6 +60,8 @@ Namespace* NS_SXP = nullptr;
 Var* VAR_CUR_NS = nullptr;
 Var* VAR_PRINT_READABLY = nullptr;
 Var* VAR_FLUSH_ON_NEWLINE = nullptr;
+Var* VAR_INLINE_PROCS = nullptr;
+Var* VAR_INLINE_FNS = nullptr;
 Var* VAR_IN = nullptr;
 Var* VAR_OUT = nullptr;
 Var* VAR_ERR = nullptr;
@@ -70,7 +74,11 @@ Keyword* KW_TAG = nullptr;
 Keyword* KW_DOC = nullptr;
 Keyword* KW_PARAMS = nullptr;
 Keyword* KW_ONCE = nullptr;
+Keyword* KW_INLINE = nullptr;
+Keyword* KW_MUTABLE = nullptr;
 Keyword* KW_DYNAMIC = nullptr;
+Keyword* KW_REDEF = nullptr;
+Keyword* KW_DIRECT_LINK = nullptr;
 Keyword* KW_APP = nullptr;
 Keyword* KW_BINARY = nullptr;
 Keyword* KW_IN = nullptr;
@@ -96,7 +104,7 @@ void gc(void) {
     }
 }
 
-static std::string commify(long x) {
+std::string commify(long x) {
     std::stringstream ss;
     ss << x;
     std::string s = ss.str();
@@ -126,8 +134,8 @@ void shutdown() {
     // Bool::shutdown();
     Namespace::shutdown();
     specials.clear();
-    std::cout << "\nVM instructions executed: "
-              << commify(VM::nInstructions());
+    if (VM::stats().nInstructions)
+        VM::stats().print(std::cout);
     printGCInfo();
 }
 
@@ -183,6 +191,7 @@ static void initDefaultImports() {
 
 void init() {
     vmTrace = false;            // ...maybe a cl option
+    vmStats = false;
     T = Bool::create(true);
     F = Bool::create(false);
     Integer::init();
@@ -215,12 +224,16 @@ void init() {
     NS_SXP = Namespace::fetch(Symbol::create("sxp"));
     // 
     KW_DYNAMIC = Keyword::fetch("dynamic");
+    KW_REDEF = Keyword::fetch("redef");
+    KW_DIRECT_LINK = Keyword::fetch("direct-link");
     KW_MACRO = Keyword::fetch("macro");
     KW_PRIVATE = Keyword::fetch("private");
     KW_TAG = Keyword::fetch("tag");
     KW_DOC = Keyword::fetch("doc");
     KW_PARAMS = Keyword::fetch("params");
     KW_ONCE = Keyword::fetch("once");
+    KW_INLINE = Keyword::fetch("inline");
+    KW_MUTABLE = Keyword::fetch("mutable");
     KW_APP = Keyword::fetch("app");
     KW_BINARY = Keyword::fetch("binary");
     KW_IN = Keyword::fetch("in");
@@ -244,6 +257,30 @@ void init() {
                                        Symbol::create("*flush-on-newline*"),
                                        rt::T);
     VAR_FLUSH_ON_NEWLINE->setDynamic();
+    VAR_INLINE_PROCS = Var::intern(NS_SXP,
+                                   Symbol::create("*inline-procs*"),
+                                   rt::T)
+        ->withMeta(Hashmap::create({
+                    KW_DOC,
+                    String::create("When true, the compiler replaces a call"
+                                   " to +, -, *, /, ==, <, =, inc, dec or nth"
+                                   " with an instruction, and calls a pure"
+                                   " core fn with constant args at compile"
+                                   " time. Bind it to false while"
+                                   " compiling code that redefines them.")
+                }));
+    VAR_INLINE_PROCS->setDynamic();
+    VAR_INLINE_FNS = Var::intern(NS_SXP,
+                                 Symbol::create("*inline-fns*"),
+                                 rt::T)
+        ->withMeta(Hashmap::create({
+                    KW_DOC,
+                    String::create("When true, the compiler expands a call"
+                                   " to a fn defined with {:inline true}"
+                                   " meta in place, see (ir form). Bind it"
+                                   " to false to compile ordinary calls.")
+                }));
+    VAR_INLINE_FNS->setDynamic();
     VAR_NS = Var::intern(NS_SXP, SYM_NS, rt::F);
     /*
       The compiler somewhat ensures any reference to IN-NS will point to this
@@ -287,6 +324,8 @@ Namespace* currentNS(Namespace* ns) {
 std::string typeName(Obj* obj) {
     if (obj == NIL)
         return "SxNil";
+    if (isImmediate(obj))
+        return isFixnum(obj) ? "SxInteger" : "SxCharacter";
     return obj->typeName();
 }
 
@@ -313,13 +352,13 @@ Symbol* genSym(const std::string& prefix, const std::string& suffix) {
 }
 
 void loadFile(const std::string& fileName) {
-    VM vm;
+    PooledVM vm;
     Obj* x;
     FStream* s = FStream::create(fileName, std::ios_base::in);
     DynScope ds(VAR_CUR_NS, currentNS());
     while ((x = reader::readOne(s, false, SENTINEL)) != SENTINEL)
         // std::cout << toString(x) << std::endl;
-        vm.run(compiler::compile(x));
+        vm->run(compiler::compile(x));
 }
 
 Obj* get(Obj* coll, Obj* key, Obj* notFound) {
@@ -355,6 +394,14 @@ bool flushOnNewline() {
     return toBool(VAR_FLUSH_ON_NEWLINE->get());
 }
 
+bool inlineProcs() {
+    return toBool(VAR_INLINE_PROCS->get());
+}
+
+bool inlineFns() {
+    return toBool(VAR_INLINE_FNS->get());
+}
+
 
 // =========================================================================
 // IObj
@@ -362,6 +409,10 @@ bool flushOnNewline() {
 std::string toString(Obj* obj) {
     if (obj == NIL)
         return "nil";
+    if (isFixnum(obj))
+        return std::to_string(fixnumVal(obj));
+    if (isImmediate(obj))
+        return boxImmediate(obj)->toString();
     return obj->toString();
 }
 
@@ -371,9 +422,28 @@ bool toBool(Obj* obj) {
     return true;
 }
 
+size_t getHash(Obj* obj) {
+    if (obj == NIL)
+        return 0;
+    if (isFixnum(obj))
+        return std::hash<long>()(fixnumVal(obj)); // same as Integer
+    if (isImmediate(obj))
+        return std::hash<char>()(immCharVal(obj)); // same as Character
+    return obj->getHash();
+}
+
 bool isEqualTo(Obj* o1, Obj* o2) {
     if (o1 == NIL)
         return o2 == NIL;
+    if (o1 == o2)
+        return true;
+    if (isImmediate(o1)) {
+        if (o2 == NIL)
+            return false;
+        if (isImmediate(o2))
+            return false;       // different words, different values
+        return o2->isEqualTo(o1); // o2 may be a box
+    }
     return o1->isEqualTo(o2);
 }
 
@@ -448,7 +518,7 @@ ISeq* seq(Obj* obj) {
     if (ISeqable* s = pISeqable(obj))
         return s->seq();
     std::stringstream ss;
-    ss << obj->typeName() << " does not implement ISeqable";
+    ss << typeName(obj) << " does not implement ISeqable";
     throw SxNotImplementedError(ss.str());
 }
 
@@ -459,7 +529,7 @@ Obj* nth(Obj* obj, int i) {
     if (IIndexed* p = cpIIndexed(obj))
         return p->nth(i);
     std::stringstream ss;
-    ss << ((obj == NIL) ? "SxNil" : obj->typeName())
+    ss << typeName(obj)
        << " does not implement IIndexed";
     throw SxNotImplementedError(ss.str());
 }
@@ -468,7 +538,7 @@ Obj* nth(Obj* obj, int i, Obj* notFound) {
     if (IIndexed* p = cpIIndexed(obj))
         return p->nth(i, notFound);
     std::stringstream ss;
-    ss << ((obj == NIL) ? "SxNil" : obj->typeName())
+    ss << typeName(obj)
        << " does not implement IIndexed";
     throw SxNotImplementedError(ss.str());
 }
@@ -482,7 +552,7 @@ int count(Obj* obj) {
     if (ICollection* c = pICollection(obj))
         return c->count();
     std::stringstream ss;
-    ss << obj->typeName() << " does not implement ICollection";
+    ss << typeName(obj) << " does not implement ICollection";
     throw SxNotImplementedError(ss.str());
 }
 
@@ -492,7 +562,7 @@ bool isEmpty(Obj* obj) {
     if (ICollection* c = pICollection(obj))
         return c->isEmpty();
     std::stringstream ss;
-    ss << obj->typeName() << " does not implement ICollection";
+    ss << typeName(obj) << " does not implement ICollection";
     throw SxNotImplementedError(ss.str());
 }
 
@@ -502,7 +572,7 @@ ICollection* conj(Obj* coll, Obj* obj) {
     if (ICollection* c = pICollection(coll))
         return c->conj(obj);
     std::stringstream ss;
-    ss << coll->typeName() << " does not implement ICollection";
+    ss << typeName(coll) << " does not implement ICollection";
     throw SxNotImplementedError(ss.str());
 }
 
@@ -510,17 +580,14 @@ ICollection* conj(Obj* coll, Obj* obj) {
 // IAssociative
 
 IAssociative* assoc(Obj* coll, Obj* key, Obj* val) {
-    if (coll == NIL) {
-        Hashmap* m = Hashmap::create();
-        m->assoc(key, val);
-        return m;
-    }
+    if (coll == NIL)
+        return Hashmap::create()->assoc(key, val);
     else if (IAssociative* p = pIAssociative(coll))
         return p->assoc(key, val);
     // else if (IIndexed* p pIIndexed(coll))
     //     return p->setNth(key, val);
     std::stringstream ss;
-    ss << coll->typeName() << " does not implement IAssociative or IIndexed";
+    ss << typeName(coll) << " does not implement IAssociative or IIndexed";
     throw SxNotImplementedError(ss.str());
 }
 
@@ -530,7 +597,7 @@ IAssociative* dissoc(Obj* coll, Obj* key) {
     else if (IAssociative* a = pIAssociative(coll))
         return a->dissoc(key);
     std::stringstream ss;
-    ss << coll->typeName() << " does not implement IAssociative";
+    ss << typeName(coll) << " does not implement IAssociative";
     throw SxNotImplementedError(ss.str());
 }
 
@@ -540,7 +607,7 @@ bool hasKey(Obj* coll, Obj* key) {
     else if (IAssociative* a = pIAssociative(coll))
         return a->hasKey(key);
     std::stringstream ss;
-    ss << coll->typeName() << " does not implement IAssociative";
+    ss << typeName(coll) << " does not implement IAssociative";
     throw SxNotImplementedError(ss.str());
 }
 
@@ -550,7 +617,7 @@ MapEntry* entryAt(Obj* coll, Obj* key) {
     else if (IAssociative* a = pIAssociative(coll))
         return a->entryAt(key);
     std::stringstream ss;
-    ss << coll->typeName() << " does not implement IAssociative";
+    ss << typeName(coll) << " does not implement IAssociative";
     throw SxNotImplementedError(ss.str());
 }
 
@@ -560,7 +627,7 @@ Obj* valAt(Obj* coll, Obj* key, Obj* notFound) {
     else if (IAssociative* a = pIAssociative(coll))
         return a->valAt(key);
     std::stringstream ss;
-    ss << coll->typeName() << " does not implement IAssociative";
+    ss << typeName(coll) << " does not implement IAssociative";
     throw SxNotImplementedError(ss.str());
 }
 
@@ -568,8 +635,8 @@ Obj* valAt(Obj* coll, Obj* key, Obj* notFound) {
 // ICopy
 
 Obj* copy(Obj* obj) {
-    if (obj == NIL)
-        return NIL;
+    if (obj == NIL || isImmediate(obj))
+        return obj;
     return obj->copy();
     /*
       if (ICopy* p = pICopy(obj))
@@ -10,6 +10,11 @@
 namespace rt {
 
 extern bool vmTrace;
+extern bool vmStats;
+extern bool directLink;
+
+// true if VM::run() must use its tracing and counting loop
+inline bool vmInstrumented() { return vmTrace || vmStats; }
 
 extern Bool* T;
 extern Bool* F;
@@ -20,8 +25,8 @@ extern SysOutStream* SYS_ERR;
 
 extern Obj* UNBOUND;
 extern Obj* SENTINEL;
-extern INumber* INT_ZERO;
-extern INumber* INT_ONE;
+extern Obj* INT_ZERO;
+extern Obj* INT_ONE;
 
 extern Symbol* SYM_UNQUOTE;
 extern Symbol* SYM_UNQUOTE_SPLICING;
@@ -64,7 +69,11 @@ extern Keyword* KW_TAG;
 extern Keyword* KW_DOC;
 extern Keyword* KW_PARAMS;
 extern Keyword* KW_ONCE;
+extern Keyword* KW_INLINE;
+extern Keyword* KW_MUTABLE;
 extern Keyword* KW_DYNAMIC;
+extern Keyword* KW_REDEF;
+extern Keyword* KW_DIRECT_LINK;
 // stream open mode flags
 extern Keyword* KW_APP;
 extern Keyword* KW_BINARY;
@@ -93,6 +102,7 @@ bool isSpecial(Obj*);
 std::string genName(const std::string& prefix, const std::string& suffix);
 Symbol* genSym(const std::string& prefix, const std::string& suffix);
 size_t nextID();
+std::string commify(long);
 void loadFile(const std::string& fileName);
 
 Obj* currentIN();
@@ -101,6 +111,8 @@ Obj* currentERR();
 
 bool printReadably();
 bool flushOnNewline();
+bool inlineProcs();
+bool inlineFns();
 
 // IObj
 std::string toString(Obj*);
@@ -108,6 +120,52 @@ bool toBool(Obj*);
 size_t getHash(Obj*);
 bool isEqualTo(Obj*, Obj*);
 
+// INumber. Two fixnums are handled inline without boxing, anything else is
+// passed on to the INumber methods.
+inline Obj* add(Obj* x, Obj* y) {
+    if (isFixnum(x) && isFixnum(y))
+        return Integer::fetch(fixnumVal(x) + fixnumVal(y));
+    return cpINumber(x)->add(cpINumber(y));
+}
+inline Obj* sub(Obj* x, Obj* y) {
+    if (isFixnum(x) && isFixnum(y))
+        return Integer::fetch(fixnumVal(x) - fixnumVal(y));
+    return cpINumber(x)->sub(cpINumber(y));
+}
+inline Obj* mul(Obj* x, Obj* y) {
+    long r;
+    if (isFixnum(x) && isFixnum(y)
+        && !__builtin_mul_overflow(fixnumVal(x), fixnumVal(y), &r))
+        return Integer::fetch(r);
+    return cpINumber(x)->mul(cpINumber(y));
+}
+inline Obj* div(Obj* x, Obj* y) {
+    if (isFixnum(x) && isFixnum(y) && fixnumVal(y)
+        && fixnumVal(x) % fixnumVal(y) == 0)
+        return Integer::fetch(fixnumVal(x) / fixnumVal(y));
+    return cpINumber(x)->div(cpINumber(y));
+}
+inline Obj* neg(Obj* x) {
+    if (isFixnum(x))
+        return Integer::fetch(-fixnumVal(x));
+    return cpINumber(x)->neg();
+}
+inline bool numEq(Obj* x, Obj* y) {
+    if (isFixnum(x) && isFixnum(y))
+        return x == y;
+    return cpINumber(x)->eq(cpINumber(y));
+}
+inline bool lt(Obj* x, Obj* y) {
+    if (isFixnum(x) && isFixnum(y))
+        return fixnumVal(x) < fixnumVal(y);
+    return cpINumber(x)->lt(cpINumber(y));
+}
+inline long toInt(Obj* x) {
+    if (isFixnum(x))
+        return fixnumVal(x);
+    return cpINumber(x)->toInt();
+}
+
 // IMeta
 Hashmap* meta(Obj*);
 Obj* withMeta(Obj*, Hashmap*);
@@ -33,7 +33,7 @@ void String::dumpCache() {
 String::String(const std::string& s)
     : _val(s),
       _hash(std::hash<std::string>()(s)) {
-    _typeName = "SxString";
+    _typeId = TID_String;
 }
 
 // IObj
@@ -72,7 +72,7 @@ size_t String::getHash() {
 bool String::isEqualTo(Obj* obj) {
     if (this == obj)
         return true;
-    if (String* s = dynamic_cast<String*>(obj))
+    if (String* s = pString(obj))
         return s->_val == _val;
     return false;
 }
@@ -81,29 +81,25 @@ bool String::isEqualTo(Obj* obj) {
 // ISeqable
 
 ISeq* String::seq() {
-    ISeq* ret = NIL;
-    for (auto itr = _val.crbegin(); itr!=_val.crend(); ++itr)
-        ret = rt::cons(ret, Character::fetch(*itr));
-    return ret;
+    if (_val.empty())
+        return NIL;
+    return StringSeq::create(this);
 }
 
 // =========================================================================
 // IIndexed
 
 Obj* String::nth(int i) {
-    if (i >= 0)
-        for (int j=0; j<(int)_val.size(); ++j)
-            if (j == i)
-                return Character::fetch(_val[i]);
+    if (i >= 0 && i < count())
+        return Character::fetch(_val[i]);
     std::stringstream ss;
-    ss << _typeName << " index (" << i << ") out of bounds";
+    ss << typeName() << " index (" << i << ") out of bounds";
     throw SxOutOfBoundsError(ss.str());
 }
 
 Obj* String::nth(int i, Obj* notFound) {
-    for (int j=0; j<(int)_val.size(); ++j)
-        if (j == i)
-            return Character::fetch(_val[i]);
+    if (i >= 0 && i < count())
+        return Character::fetch(_val[i]);
     return notFound;
 }
 
@@ -119,7 +115,7 @@ bool String::isEmpty() {
 }
 
 ICollection* String::conj(Obj* obj) {
-    if (Character* c = dynamic_cast<Character*>(obj)) {
+    if (Character* c = pCharacter(obj)) {
         String* s = new String(_val);
         s += c->val();
         return s;
@@ -61,14 +61,14 @@ void FStream::print(Obj* x) {
     ensureOpen();
     if (!(_mode & std::ios_base::out)) 
         throw SxIOError("SStream is not an output stream"); 
-    (*_s) << (!x ? "nil" : x->toString()); 
+    (*_s) << rt::toString(x); 
 }
 
 void FStream::println(Obj* x) { 
     ensureOpen();
     if (!(_mode & std::ios_base::out)) 
         throw SxIOError(_name + " is not an output stream"); 
-    (*_s) << (!x ? "nil" : x->toString()) << '\n'; 
+    (*_s) << rt::toString(x) << '\n'; 
 }
  
 void FStream::print(const std::string& s) { 
@@ -95,13 +95,13 @@ void SStream::close() {
 void SStream::print(Obj* x) { 
     if (!(_mode & std::ios_base::out)) 
         throw SxIOError("SStream is not an output stream"); 
-    (*_s) << (!x ? "nil" : x->toString()); 
+    (*_s) << rt::toString(x); 
 }
 
 void SStream::println(Obj* x) { 
     if (!(_mode & std::ios_base::out)) 
         throw SxIOError("SStream is not an output stream"); 
-    (*_s) << (!x ? "nil" : x->toString()) << '\n'; 
+    (*_s) << rt::toString(x) << '\n'; 
 }
  
 void SStream::print(const std::string& s) { 
@@ -26,7 +26,7 @@ struct SysInStream : IInStream {
     static SysInStream* create(const std::string& name, std::istream& s);
     std::string toString() {
         std::stringstream ss;
-        ss << "#<" << _typeName << ' ' << _name << openModeToStr(mode())
+        ss << "#<" << typeName() << ' ' << _name << openModeToStr(mode())
            << ' ' << this << '>';
         return ss.str();
     }
@@ -42,7 +42,7 @@ protected:
     std::istream& _s;
     SysInStream(const std::string& name, std::istream& s)
         : _name(name), _s(s) {
-        _typeName = "SxSysInStream";
+        _typeId = TID_SysInStream;
     }
 };
 DEF_CASTER(SysInStream)
@@ -51,7 +51,7 @@ struct SysOutStream : IOutStream {
     static SysOutStream* create(const std::string& name, std::ostream& s);
     std::string toString() {
         std::stringstream ss;
-        ss << "#<" << _typeName << ' ' << _name
+        ss << "#<" << typeName() << ' ' << _name
            << openModeToStr(mode()) << ' ' << this << '>';
         return ss.str();
     }
@@ -60,8 +60,8 @@ struct SysOutStream : IOutStream {
     void close();
     void put(int c) { _s.put(c); }
     void flush() { _s.flush(); }
-    void print(Obj* x) { _s << (!x ? "nil" : x->toString()); }
-    void println(Obj* x) { _s << (!x ? "nil" : x->toString()) << '\n'; }
+    void print(Obj* x) { _s << rt::toString(x); }
+    void println(Obj* x) { _s << rt::toString(x) << '\n'; }
     void print(const std::string& s) { _s << s; }
     void println(const std::string& s) { _s << s << '\n'; }
     std::ostream& ostream() { return _s; }
@@ -70,7 +70,7 @@ protected:
     std::ostream& _s;
     SysOutStream(const std::string& name, std::ostream& s)
         : _name(name), _s(s) {
-        _typeName = "SxSysOutStream";
+        _typeId = TID_SysOutStream;
     }
 };
 DEF_CASTER(SysOutStream)
@@ -150,7 +150,7 @@ protected:
     }
     FStream(const std::string& name, openMode_t mode, std::fstream* s)
         : _name(name), _mode(mode), _s(s) {
-        _typeName = "SxFStream";
+        _typeId = TID_FStream;
     }
 };
 DEF_CASTER(FStream)
@@ -213,7 +213,7 @@ protected:
     std::stringstream* _s;
     SStream(openMode_t mode, std::stringstream* s)
         : _mode(mode), _s(s) {
-        _typeName = "SxSStream";
+        _typeId = TID_SStream;
     }
 };
 DEF_CASTER(SStream)
@@ -17,8 +17,8 @@
 #include <vector>               // vector impl
 #include <map>                  // treemap impl (ordered)
 #include <set>                  // treeset impl (ordered)
-#include <unordered_map>        // hashmap impl
-#include <unordered_set>        // hashset impl
+#include <unordered_map>
+#include <unordered_set>
 #include <stdexcept>            // error impl
 #include <functional>
 #include <iomanip>
@@ -27,10 +27,12 @@
 #include <cmath>
 #include <cassert>
 #include <cstring>
+#include <cstdint>
 #include <numeric>
 #include <regex>                // regex impl
 
 #include "obj.hpp"
+#include "flatmap.hpp"
 #include "error.hpp"
 #include "xface.hpp"
 #include "bool.hpp"
@@ -43,8 +45,10 @@
 #include "symbol.hpp"
 #include "regex.hpp"
 #include "list.hpp"
+#include "vectrie.hpp"
 #include "vector.hpp"
 #include "mapentry.hpp"
+#include "hamt.hpp"
 #include "hashmap.hpp"
 #include "hashset.hpp"
 #include "treemap.hpp"
@@ -55,10 +59,13 @@
 #include "stream.hpp"
 #include "var.hpp"
 #include "namespace.hpp"
+#include "vasm.hpp"
 #include "vm.hpp"
 #include "rt.hpp"
+#include "argseq.hpp"
+#include "aseq.hpp"
 #include "reader.hpp"
 #include "compiler.hpp"
-#include "vasm.hpp"
+#include "ir.hpp"
 
 #endif // SXP_HPP_INCLUDED
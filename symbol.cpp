@@ -60,7 +60,7 @@ Symbol::Symbol(const std::string& nsName,
       _hash(std::hash<std::string>()(_nsName.empty() ? _name
                                      : _nsName + "/" + _name)),
       _meta(nullptr) {
-    _typeName = "SxSymbol";
+    _typeId = TID_Symbol;
 }
 
 // =========================================================================
@@ -38,7 +38,7 @@ Treemap* Treemap::create(treemap_t keysvals) {
 
 Treemap::Treemap()
     : Fn("SxTreemap"), _impl() {
-    _typeName = "SxTreemap";
+    _typeId = TID_Treemap;
     createMethods();
 }
 
@@ -96,7 +96,7 @@ std::string Treemap::toString() {
 
 size_t Treemap::getHash() {
     std::stringstream ss;
-    ss << _typeName << " is not hashable";
+    ss << typeName() << " is not hashable";
     throw SxRuntimeError(ss.str());
 }
 
@@ -128,12 +128,11 @@ Treemap* Treemap::copy() {
 ISeq* Treemap::seq() {
     if (isEmpty())
         return NIL;
-    ISeq* ret = NIL, *tmp = NIL;
-    for (auto pair : _impl)
-        tmp = rt::cons(tmp, MapEntry::create(pair.first, pair.second));
-    // reverse it to match the order of the printed rep of this treemap
-    for (; tmp; tmp=tmp->next())
-        ret = rt::cons(ret, tmp->first());
+    // a copy, the tree changes in place. Cons'd from the end to match the
+    // order of the printed rep of this treemap.
+    ISeq* ret = NIL;
+    for (auto itr=_impl.crbegin(); itr!=_impl.crend(); ++itr)
+        ret = rt::cons(ret, MapEntry::create(itr->first, itr->second));
     return ret;
 }
 
@@ -149,7 +148,7 @@ bool Treemap::isEmpty() {
 }
 
 ICollection* Treemap::conj(Obj* obj) {
-    if (MapEntry* me = dynamic_cast<MapEntry*>(obj)) {
+    if (MapEntry* me = pMapEntry(obj)) {
         _impl[cpISortable(me->key())] = me->val();
         return this;
     }
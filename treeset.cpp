@@ -141,6 +141,6 @@ void Treeset::createMethods() {
 Treeset::Treeset()
     : Fn("SxTreeset"),
       _impl() {
-    _typeName = "SxTreeset";
+    _typeId = TID_Treeset;
     createMethods();
 }
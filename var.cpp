@@ -17,12 +17,13 @@ Var::Var(Namespace* ns, Symbol* sym, Obj* root)
       _rootVal(root),
       _dynVals(),
       _meta(Hashmap::create()) {
-    _typeName = "SxVar";
+    _typeId = TID_Var;
 }
 
 Var* Var::intern(Namespace* ns, Symbol* sym, Obj* root) {
     Var* v = ns->intern(sym);
     v->_rootVal = root;
+    v->relink();
     return v;
 }
 
@@ -39,8 +40,8 @@ Var* Var::create(Namespace* ns, Symbol* sym, Obj* root) {
 }
 
 void Var::pushBindings(Hashmap* m) {
-    for (auto itr=m->impl().begin(); itr!=m->impl().end(); ++itr)
-        pVar(itr->first)->pushDyn(itr->second);
+    for (auto e : m->impl())
+        pVar(e.first)->pushDyn(e.second);
     _dynVars.push_back(rt::keys(m));
 }
 
@@ -79,8 +80,36 @@ Obj* Var::setRoot(Obj* x, bool resetMacro) {
         rt::warning("rebinding root value of currently dynamically bound"
                     " var: " + toString());
     if (resetMacro)
-        _meta->dissoc(rt::KW_MACRO);
-    return _rootVal = x;
+        _meta = cpHashmap(_meta->dissoc(rt::KW_MACRO));
+    _rootVal = x;
+    relink();
+    return x;
+}
+
+/*
+  Direct linking. Code compiled with direct linking on loads a linkable
+  var's root from a constant pool slot of its own instead of loading the var
+  and doing a VAR_GET. The var remembers each such slot and rewrites it
+  whenever it gets a new root, so a DEF or SET! is still seen by the code
+  already compiled. A var is linkable if it's not dynamic, not a macro, not
+  marked ^:redef, and either sxp was started with --direct-link or its
+  namespace's meta has :direct-link true.
+*/
+bool Var::isLinkable() {
+    if (!_ns || isDynamic() || isMacro()
+        || rt::toBool(_meta->valAt(rt::KW_REDEF)))
+        return false;
+    return rt::directLink
+        || rt::toBool(_ns->meta()->valAt(rt::KW_DIRECT_LINK));
+}
+
+void Var::link(Fn* fn, int index) {
+    _links.push_back({fn, index});
+}
+
+void Var::relink() {
+    for (auto& l : _links)
+        l.fn->setConstant(l.index, _rootVal);
 }
 
 void Var::pushDyn(Obj* x) {
@@ -97,7 +126,10 @@ void Var::popDyn() {
 }
 
 void Var::setDynamic() {
-    _meta->assoc(rt::KW_DYNAMIC, rt::T);
+    if (!_links.empty())
+        rt::warning("direct linked code will not see the bindings of: "
+                    + toString());
+    _meta = cpHashmap(_meta->assoc(rt::KW_DYNAMIC, rt::T));
 }
 
 bool Var::isDynamic() {
@@ -118,7 +150,11 @@ bool Var::isPublic() {
 
 Var* Var::withMeta(Hashmap* m) {
     if (rt::isEqualTo(m->valAt(rt::KW_TAG), rt::KW_DYNAMIC))
-        m->dissoc(rt::KW_TAG)->assoc(rt::KW_DYNAMIC, rt::T);
+        m = cpHashmap(m->dissoc(rt::KW_TAG)->assoc(rt::KW_DYNAMIC, rt::T));
+    if (!_links.empty() && !isDynamic()
+        && rt::toBool(m->valAt(rt::KW_DYNAMIC)))
+        rt::warning("direct linked code will not see the bindings of: "
+                    + toString());
     _meta = m;
     return this;
 }
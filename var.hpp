@@ -9,6 +9,12 @@
 
 struct Namespace;
 
+// a constant pool slot holding a copy of a var's root, see Var::link()
+struct VarLink {
+    Fn* fn;
+    int index;
+};
+
 struct Var : IMeta {
     friend struct Namespace;
     static Var* intern(Namespace*, Symbol*, Obj*);
@@ -31,6 +37,8 @@ struct Var : IMeta {
     bool isDynBound() { return !_dynVals.empty(); }
     bool isMacro();
     bool isPublic();
+    bool isLinkable();
+    void link(Fn*, int);
     // IMeta
     Hashmap* meta() { return _meta; }
     Var* withMeta(Hashmap* m);
@@ -41,7 +49,9 @@ protected:
     Obj* _rootVal;
     vecobj_t _dynVals;
     Hashmap* _meta;
+    std::vector<VarLink, gc_allocator<VarLink>> _links;
     Var(Namespace*, Symbol*, Obj*);
+    void relink();
 };
 DEF_CASTER(Var)
 
@@ -9,7 +9,8 @@
 namespace vasm {
 
 enum OperandType {
-    NONE, U8, U16
+    NONE, U8, U16,
+    SITE                        // U16 CallCache index, always last
 };
 
 struct OpcodeInfo {
@@ -17,6 +18,7 @@ struct OpcodeInfo {
     Opcode opcode;
     int operandCount;
     OperandType type;
+    OperandType type2;          // of the second operand, if any
 };
 
 static std::map<int, OpcodeInfo> opcodeMap = {
@@ -69,16 +71,18 @@ static std::map<int, OpcodeInfo> opcodeMap = {
     {STORE_FREE_3, {"STORE_FREE_3", STORE_FREE_3, 0, NONE}},
     {STORE_FREE_4, {"STORE_FREE_4", STORE_FREE_4, 0, NONE}},
     {STORE_FREE_B, {"STORE_FREE_B", STORE_FREE_B, 1, U8}},
+    {LOAD_UPVAL_B, {"LOAD_UPVAL_B", LOAD_UPVAL_B, 1, U8}},
+    {STORE_UPVAL_B, {"STORE_UPVAL_B", STORE_UPVAL_B, 1, U8}},
     {NEW_CLOSURE, {"NEW_CLOSURE", NEW_CLOSURE, 0, NONE}},
     {DEF, {"DEF", DEF, 0, NONE}},
     {VAR_GET, {"VAR_GET", VAR_GET, 0, NONE}},
-    {CALL_0, {"CALL_0", CALL_0, 0, NONE}},
-    {CALL_1, {"CALL_1", CALL_1, 0, NONE}},
-    {CALL_2, {"CALL_2", CALL_2, 0, NONE}},
-    {CALL_3, {"CALL_3", CALL_3, 0, NONE}},
-    {CALL_4, {"CALL_4", CALL_4, 0, NONE}},
-    {CALL_B, {"CALL_B", CALL_B, 1, U8}},
-    {CALL_S, {"CALL_S", CALL_S, 1, U16}},
+    {CALL_0, {"CALL_0", CALL_0, 1, SITE}},
+    {CALL_1, {"CALL_1", CALL_1, 1, SITE}},
+    {CALL_2, {"CALL_2", CALL_2, 1, SITE}},
+    {CALL_3, {"CALL_3", CALL_3, 1, SITE}},
+    {CALL_4, {"CALL_4", CALL_4, 1, SITE}},
+    {CALL_B, {"CALL_B", CALL_B, 2, U8, SITE}},
+    {CALL_S, {"CALL_S", CALL_S, 2, U16, SITE}},
     {CALL_PROC, {"CALL_PROC", CALL_PROC, 1, U16}},
     {CALL_CFN, {"CALL_CFN", CALL_CFN, 0, NONE}},
     {RETURN, {"RETURN", RETURN, 0, NONE}},
@@ -91,6 +95,48 @@ static std::map<int, OpcodeInfo> opcodeMap = {
     {VAR_SET, {"VAR_SET", VAR_SET, 0, NONE}}, // 68 instructions
     {JSR, {"JSR", JSR, 1, U16}},
     {RET, {"RET", RET, 0, NONE}},
+    {TAIL_CALL_0, {"TAIL_CALL_0", TAIL_CALL_0, 1, SITE}},
+    {TAIL_CALL_1, {"TAIL_CALL_1", TAIL_CALL_1, 1, SITE}},
+    {TAIL_CALL_2, {"TAIL_CALL_2", TAIL_CALL_2, 1, SITE}},
+    {TAIL_CALL_3, {"TAIL_CALL_3", TAIL_CALL_3, 1, SITE}},
+    {TAIL_CALL_4, {"TAIL_CALL_4", TAIL_CALL_4, 1, SITE}},
+    {TAIL_CALL_B, {"TAIL_CALL_B", TAIL_CALL_B, 2, U8, SITE}},
+    {TAIL_CALL_S, {"TAIL_CALL_S", TAIL_CALL_S, 2, U16, SITE}},
+    {SELF_CALL, {"SELF_CALL", SELF_CALL, 1, U16}},
+    {TAIL_SELF_CALL, {"TAIL_SELF_CALL", TAIL_SELF_CALL, 1, U16}},
+    // inlined core procs
+    {ADD, {"ADD", ADD, 0, NONE}},
+    {SUB, {"SUB", SUB, 0, NONE}},
+    {MUL, {"MUL", MUL, 0, NONE}},
+    {DIV, {"DIV", DIV, 0, NONE}},
+    {EQEQ, {"EQEQ", EQEQ, 0, NONE}},
+    {LT, {"LT", LT, 0, NONE}},
+    {EQ, {"EQ", EQ, 0, NONE}},
+    {INC, {"INC", INC, 0, NONE}},
+    {DEC, {"DEC", DEC, 0, NONE}},
+    {NTH, {"NTH", NTH, 0, NONE}},
+    // quickened forms
+    {ADD_INT_INT, {"ADD_INT_INT", ADD_INT_INT, 0, NONE}},
+    {SUB_INT_INT, {"SUB_INT_INT", SUB_INT_INT, 0, NONE}},
+    {LT_INT_INT, {"LT_INT_INT", LT_INT_INT, 0, NONE}},
+    {EQEQ_INT_INT, {"EQEQ_INT_INT", EQEQ_INT_INT, 0, NONE}},
+    {INC_INT, {"INC_INT", INC_INT, 0, NONE}},
+    {DEC_INT, {"DEC_INT", DEC_INT, 0, NONE}},
+    {NTH_VECTOR, {"NTH_VECTOR", NTH_VECTOR, 0, NONE}},
+    {LT_INT_INT_JUMP_IF_FALSE,
+     {"LT_INT_INT_JUMP_IF_FALSE", LT_INT_INT_JUMP_IF_FALSE, 1, U16}},
+    {EQEQ_INT_INT_JUMP_IF_FALSE,
+     {"EQEQ_INT_INT_JUMP_IF_FALSE", EQEQ_INT_INT_JUMP_IF_FALSE, 1, U16}},
+    // superinstructions, see peephole()
+    {LOAD_VAR, {"LOAD_VAR", LOAD_VAR, 1, U8}},
+    {LOAD_LOCAL_LOAD_LOCAL,
+     {"LOAD_LOCAL_LOAD_LOCAL", LOAD_LOCAL_LOAD_LOCAL, 2, U8, U8}},
+    {LOAD_LOCAL_LOAD_CONST,
+     {"LOAD_LOCAL_LOAD_CONST", LOAD_LOCAL_LOAD_CONST, 2, U8, U8}},
+    {LT_JUMP_IF_FALSE,
+     {"LT_JUMP_IF_FALSE", LT_JUMP_IF_FALSE, 1, U16}},
+    {EQEQ_JUMP_IF_FALSE,
+     {"EQEQ_JUMP_IF_FALSE", EQEQ_JUMP_IF_FALSE, 1, U16}},
 };
 
 /*
@@ -119,6 +165,9 @@ static std::map<int, std::string> procNames = {
     {EQ_2N, "EQ_2N"},
     {VM_TRACE_0, "VM_TRACE_0"},
     {VM_STACK_0, "VM_STACK_0"},
+    {VM_STATS_0, "VM_STATS_0"},
+    {VM_STATS_PRINT_0, "VM_STATS_PRINT_0"},
+    {GC_BYTES_0, "GC_BYTES_0"},
     {COMPILE_1, "COMPILE_1"},
     {IDENTICAL_P_2, "IDENTICAL_P_2"},
     {META_1, "META_1"},
@@ -173,6 +222,7 @@ static std::map<int, std::string> procNames = {
     {PUSH_BINDINGS_1, "PUSH_BINDINGS_1"},
     {POP_BINDINGS_0, "POP_BINDINGS_0"},
     {MACROEXPAND_1_1, "MACROEXPAND_1_1"},
+    {IR_1, "IR_1"},
     {SEQ_P_1, "SEQ_P_1"},
     {SEQABLE_P_1, "SEQABLE_P_1"},
     {NUMBER_P_1, "NUMBER_P_1"},
@@ -233,17 +283,65 @@ static std::map<int, std::string> procNames = {
     {LT_1, "LT_1"},
     {LT_2, "LT_2"},
     {LT_2N, "LT_2N"},
+    {INC_1, "INC_1"},
+    {DEC_1, "DEC_1"},
 };
 
+// Return the name of the opcode or proc id, or "?" if it's unknown.
+const char* opName(int id) {
+    if (id < 256) {
+        auto itr = opcodeMap.find(id);
+        return itr != opcodeMap.end() ? itr->second.name : "?";
+    }
+    auto itr = procNames.find(id);
+    return itr != procNames.end() ? itr->second.c_str() : "?";
+}
+
+// print the operand of the given type at addr, return the addr after it
+static int disOperand(const FnMethod* m, int addr, OperandType type,
+                      std::ostream& s) {
+    switch (type) {
+        case NONE: break;
+        case U8: {
+            int x = m->bc()[addr++];
+            s << std::setw(2) << std::hex << std::setfill('0') << x;
+            s << std::dec << " (" << x << ")";
+            break;
+        }
+        case U16: {
+            int x = m->bc()[addr] | m->bc()[addr + 1] << 8;
+            s << std::setw(4) << std::hex << std::setfill('0') << x;
+            std::string name = "";
+            auto itr = procNames.find(x);
+            if (itr != procNames.end())
+                name = itr->second;
+            // print the procID name, if found in the procNames map-.
+            //                                     .----------------'
+            //                                     v
+            s << std::dec << " (" << x << ") " << name;
+            addr += 2;
+            break;
+        }
+        case SITE: {
+            int x = m->bc()[addr] | m->bc()[addr + 1] << 8;
+            s << "ic " << std::dec << x;
+            addr += 2;
+            break;
+        }
+    }
+    return addr;
+}
+
 int disOne(const FnMethod* m, int addr, std::ostream& s) {
     int opcode = m->bc()[addr];
     s << std::setw(4) << std::hex << std::setfill('0')
       << addr++ << " " << opcodeMap[opcode].name;
     int n = opcodeMap[opcode].operandCount;
     if (n) {
-        // if the opcode has operands, print dots up to the 21st column
-        int j = 20 - std::strlen(opcodeMap[opcode].name);
-        while (j--)
+        // if the opcode has operands, print dots up to the 21st column, or
+        // at least one
+        int j = std::max<int>(20 - std::strlen(opcodeMap[opcode].name), 1);
+        while (j-- > 0)
             s << '.';
     }
     switch (n) {
@@ -267,33 +365,16 @@ int disOne(const FnMethod* m, int addr, std::ostream& s) {
                     break;
             }
             break;
-        case 1: {
+        case 1:
             // 1 operand
-            switch (opcodeMap[opcode].type) {
-                case NONE: break;
-                case U8: {
-                    int x = m->bc()[addr++];
-                    s << std::setw(2) << std::hex << std::setfill('0') << x;
-                    s << std::dec << " (" << x << ")";
-                    break;
-                }
-                case U16: {
-                    int x = m->bc()[addr] | m->bc()[addr + 1] << 8;
-                    s << std::setw(4) << std::hex << std::setfill('0') << x;
-                    std::string name = "";
-                    auto itr = procNames.find(x);
-                    if (itr != procNames.end())
-                        name = itr->second;
-                    // print the procID name, if found in the procNames map-.
-                    //                                     .----------------'
-                    //                                     v
-                    s << std::dec << " (" << x << ") " << name;
-                    addr += 2;
-                    break;
-                }
-            }
+            addr = disOperand(m, addr, opcodeMap[opcode].type, s);
+            break;
+        case 2:
+            // 2 operands
+            addr = disOperand(m, addr, opcodeMap[opcode].type, s);
+            s << ' ';
+            addr = disOperand(m, addr, opcodeMap[opcode].type2, s);
             break;
-        }
         default:
             assert(0 && "UNHANDLED OPCODE OPERAND COUNT");
     }
@@ -308,4 +389,394 @@ void dis(const FnMethod* m, std::ostream& s) {
         i = disOne(m, i, s);
 }
 
+static int operandSize(OperandType type) {
+    switch (type) {
+        case NONE: return 0;
+        case U8: return 1;
+        case U16:
+        case SITE: return 2;
+    }
+    return 0;
+}
+
+// Return the size in bytes of the instruction at addr.
+int instrSize(const uint8_t* code, int addr) {
+    int opcode = code[addr];
+    if (opcode == NEW_CLOSURE)
+        return 2 + 2 * code[addr + 1]; // n, then n (flags, index) pairs
+    const OpcodeInfo& info = opcodeMap.at(opcode);
+    return 1 + (info.operandCount > 0 ? operandSize(info.type) : 0)
+        + (info.operandCount > 1 ? operandSize(info.type2) : 0);
+}
+
+// =========================================================================
+// Peephole optimizer
+
+static int readU16(const vecu8_t& bc, int addr) {
+    return bc[addr] | bc[addr + 1] << 8;
+}
+
+// the index a LOAD_CONST_N at addr loads, or -1 (LOAD_CONST_S isn't fused)
+static int loadConstIndex(const vecu8_t& bc, int addr) {
+    if (bc[addr] >= LOAD_CONST_0 && bc[addr] <= LOAD_CONST_4)
+        return bc[addr] - LOAD_CONST_0;
+    return bc[addr] == LOAD_CONST_B ? bc[addr + 1] : -1;
+}
+
+// ditto for LOAD_LOCAL_N
+static int loadLocalIndex(const vecu8_t& bc, int addr) {
+    if (bc[addr] >= LOAD_LOCAL_0 && bc[addr] <= LOAD_LOCAL_4)
+        return bc[addr] - LOAD_LOCAL_0;
+    return bc[addr] == LOAD_LOCAL_B ? bc[addr + 1] : -1;
+}
+
+// follow a chain of JUMPs starting at addr to where it really goes
+static int jumpDest(const vecu8_t& bc, int addr) {
+    for (int hops=0; hops<8 && addr<(int)bc.size() && bc[addr]==JUMP; ++hops)
+        addr = readU16(bc, addr + 1);
+    return addr;
+}
+
+/*
+  Rewrite m's bytecode in a single pass:
+
+    LOAD_CONST_N VAR_GET           => LOAD_VAR n
+    LOAD_LOCAL_N LOAD_LOCAL_N      => LOAD_LOCAL_LOAD_LOCAL n n
+    LOAD_LOCAL_N LOAD_CONST_N      => LOAD_LOCAL_LOAD_CONST n n
+    LT JUMP_IF_FALSE               => LT_JUMP_IF_FALSE addr
+    EQEQ JUMP_IF_FALSE             => EQEQ_JUMP_IF_FALSE addr
+    JUMP to a JUMP                 => JUMP to where the last one goes
+    JUMP to a RETURN               => RETURN
+
+  The pairs were picked from the (vm-stats) opcode pair counts of the
+  sxpsrc/bench*.sxp files. A pair is never fused when its second
+  instruction is the target of a jump or a handler address, then every
+  jump operand and handler address is moved to the new code. Build with
+  -DSXP_NO_PEEPHOLE to compare against the unoptimized code.
+*/
+void peephole(FnMethod* m) {
+    const vecu8_t& bc = m->bc();
+    int n = bc.size();
+    std::vector<int> targets;
+    m->handlerAddrs(targets);
+    for (int a=0; a<n; a+=instrSize(bc.data(), a))
+        if (bc[a] == JUMP || bc[a] == JUMP_IF_FALSE || bc[a] == JSR) {
+            targets.push_back(readU16(bc, a + 1));
+            targets.push_back(jumpDest(bc, readU16(bc, a + 1)));
+        }
+    std::vector<bool> isTarget(n + 1);
+    for (int t : targets)
+        isTarget[t] = true;
+    vecu8_t code;
+    std::vector<int> newAddr(n + 1, -1);
+    std::vector<std::pair<int, int>> fixups; // (operand addr, old target)
+    for (int a=0; a<n; ) {
+        int b = a + instrSize(bc.data(), a); // the next instruction
+        newAddr[a] = code.size();
+        int x, y;
+        if (b < n && !isTarget[b]) {
+            if ((x = loadConstIndex(bc, a)) >= 0 && bc[b] == VAR_GET) {
+                code.insert(code.end(), {LOAD_VAR, (uint8_t)x});
+                newAddr[b] = newAddr[a];
+                a = b + 1;
+                continue;
+            }
+            if ((x = loadLocalIndex(bc, a)) >= 0) {
+                Opcode op = HALT;
+                if ((y = loadLocalIndex(bc, b)) >= 0)
+                    op = LOAD_LOCAL_LOAD_LOCAL;
+                else if ((y = loadConstIndex(bc, b)) >= 0)
+                    op = LOAD_LOCAL_LOAD_CONST;
+                if (op != HALT) {
+                    code.insert(code.end(), {op, (uint8_t)x, (uint8_t)y});
+                    newAddr[b] = newAddr[a];
+                    a = b + instrSize(bc.data(), b);
+                    continue;
+                }
+            }
+            if ((bc[a] == LT || bc[a] == EQEQ) && bc[b] == JUMP_IF_FALSE) {
+                code.push_back(bc[a] == LT ? LT_JUMP_IF_FALSE
+                               : EQEQ_JUMP_IF_FALSE);
+                fixups.push_back({code.size(),
+                                  jumpDest(bc, readU16(bc, b + 1))});
+                code.insert(code.end(), {0, 0});
+                newAddr[b] = newAddr[a];
+                a = b + 3;
+                continue;
+            }
+        }
+        switch (bc[a]) {
+            case JUMP:
+            case JUMP_IF_FALSE: {
+                int t = jumpDest(bc, readU16(bc, a + 1));
+                if (bc[a] == JUMP && t < n && bc[t] == RETURN)
+                    code.push_back(RETURN);
+                else {
+                    code.push_back(bc[a]);
+                    fixups.push_back({code.size(), t});
+                    code.insert(code.end(), {0, 0});
+                }
+                break;
+            }
+            case JSR:
+                code.push_back(JSR);
+                fixups.push_back({code.size(), readU16(bc, a + 1)});
+                code.insert(code.end(), {0, 0});
+                break;
+            default:
+                code.insert(code.end(), bc.begin() + a, bc.begin() + b);
+                break;
+        }
+        a = b;
+    }
+    newAddr[n] = code.size();
+    for (auto f : fixups) {
+        int t = newAddr[f.second];
+        assert(t >= 0 && "PEEPHOLE JUMP INTO A FUSED INSTRUCTION");
+        code[f.first] = t & 0xff;
+        code[f.first + 1] = t >> 8;
+    }
+    m->replaceCode(code, newAddr);
+}
+
+// =========================================================================
+// Bytecode verifier
+
+enum Flow {
+    NEXT,                       // falls through to the next instruction
+    GOTO,                       // only goes to its jump target
+    BRANCH,                     // either
+    END                         // neither, leaves the frame
+};
+
+/*
+  Set pops and pushes to the number of operand stack slots the instruction
+  at addr takes and leaves, and return where it goes next. count is the
+  fixnum the previous instruction loaded from the constant pool, or -1,
+  it's the element count of NEW_VECTOR and friends. The CALLs leave the
+  callee's result, whatever the callee does with its own frame.
+*/
+static Flow stackEffect(const FnMethod* m, int addr, long count,
+                        int& pops, int& pushes) {
+    const vecu8_t& bc = m->bc();
+    int op = bc[addr];
+    pops = pushes = 0;
+    switch (op) {
+        case HALT:
+            return END;
+        case POP:
+        case STORE_LOCAL_0: case STORE_LOCAL_1: case STORE_LOCAL_2:
+        case STORE_LOCAL_3: case STORE_LOCAL_4: case STORE_LOCAL_B:
+        case STORE_LOCAL_S:
+        case STORE_FREE_0: case STORE_FREE_1: case STORE_FREE_2:
+        case STORE_FREE_3: case STORE_FREE_4: case STORE_FREE_B:
+        case STORE_UPVAL_B:
+            pops = 1;
+            return NEXT;
+        case DUP:
+            pops = 1;
+            pushes = 2;
+            return NEXT;
+        case LOAD_NIL: case LOAD_TRUE: case LOAD_FALSE:
+        case LOAD_EMPTY_LIST: case LOAD_EMPTY_VECTOR:
+        case LOAD_EMPTY_HASHMAP: case LOAD_EMPTY_HASHSET:
+        case LOAD_CONST_0: case LOAD_CONST_1: case LOAD_CONST_2:
+        case LOAD_CONST_3: case LOAD_CONST_4: case LOAD_CONST_B:
+        case LOAD_CONST_S:
+        case LOAD_LOCAL_0: case LOAD_LOCAL_1: case LOAD_LOCAL_2:
+        case LOAD_LOCAL_3: case LOAD_LOCAL_4: case LOAD_LOCAL_B:
+        case LOAD_LOCAL_S:
+        case LOAD_FREE_0: case LOAD_FREE_1: case LOAD_FREE_2:
+        case LOAD_FREE_3: case LOAD_FREE_4: case LOAD_FREE_B:
+        case LOAD_UPVAL_B:
+        case LOAD_VAR:
+        case CALL_PROC:
+        case CALL_CFN:
+            pushes = 1;
+            return NEXT;
+        case LOAD_LOCAL_LOAD_LOCAL:
+        case LOAD_LOCAL_LOAD_CONST:
+            pushes = 2;
+            return NEXT;
+        case NEW_VECTOR: case NEW_LIST: case NEW_HASHSET:
+        case NEW_HASHMAP: case APPLY:
+            if (count < 0)
+                throw SxCompilerError(std::string(opName(op))
+                                      + " without a constant count");
+            pops = 1 + (op == NEW_HASHMAP ? 2 * count : count)
+                + (op == APPLY ? 1 : 0); // the callable
+            pushes = 1;
+            return NEXT;
+        case JUMP:
+            return GOTO;
+        case JUMP_IF_FALSE:
+            pops = 1;
+            return BRANCH;
+        case LT_JUMP_IF_FALSE: case EQEQ_JUMP_IF_FALSE:
+        case LT_INT_INT_JUMP_IF_FALSE: case EQEQ_INT_INT_JUMP_IF_FALSE:
+            pops = 2;
+            return BRANCH;
+        case NEW_CLOSURE: case VAR_GET:
+        case INC: case DEC: case INC_INT: case DEC_INT:
+            pops = pushes = 1;
+            return NEXT;
+        case DEF: case SET_META: case VAR_SET:
+        case ADD: case SUB: case MUL: case DIV: case EQEQ: case LT: case EQ:
+        case NTH:
+        case ADD_INT_INT: case SUB_INT_INT: case LT_INT_INT:
+        case EQEQ_INT_INT: case NTH_VECTOR:
+            pops = 2;
+            pushes = 1;
+            return NEXT;
+        case SWAP:
+            pops = pushes = 2;
+            return NEXT;
+        case SWAP2:
+            pops = pushes = 3;
+            return NEXT;
+        case CALL_0: case CALL_1: case CALL_2: case CALL_3: case CALL_4:
+            pops = 1 + op - CALL_0;
+            pushes = 1;
+            return NEXT;
+        case CALL_B:
+            pops = 1 + bc[addr + 1];
+            pushes = 1;
+            return NEXT;
+        case CALL_S:
+            pops = 1 + readU16(bc, addr + 1);
+            pushes = 1;
+            return NEXT;
+        case SELF_CALL:
+        case TAIL_SELF_CALL:
+            pops = 1 + pFnMethod(m->fn()->cp()[readU16(bc, addr + 1)])
+                ->reqArgs();
+            pushes = op == SELF_CALL;
+            return op == SELF_CALL ? NEXT : END;
+        case TAIL_CALL_0: case TAIL_CALL_1: case TAIL_CALL_2:
+        case TAIL_CALL_3: case TAIL_CALL_4:
+            pops = 1 + op - TAIL_CALL_0;
+            return END;
+        case TAIL_CALL_B:
+            pops = 1 + bc[addr + 1];
+            return END;
+        case TAIL_CALL_S:
+            pops = 1 + readU16(bc, addr + 1);
+            return END;
+        case RETURN: case THROW: case RETHROW:
+            pops = 1;
+            return END;
+        case JSR:
+            return BRANCH;      // the subroutine RETs to the next instr
+        case RET:
+            return END;
+    }
+    throw SxCompilerError(std::string("can't verify opcode ") + opName(op));
+}
+
+// the fixnum the instruction at addr loads from m's constant pool, or -1
+static long loadedCount(const FnMethod* m, int addr) {
+    const vecu8_t& bc = m->bc();
+    int i = loadConstIndex(bc, addr);
+    if (bc[addr] == LOAD_CONST_S)
+        i = readU16(bc, addr + 1);
+    else if (bc[addr] == LOAD_LOCAL_LOAD_CONST)
+        i = bc[addr + 2];
+    if (i < 0)
+        return -1;
+    Obj* x = m->fn()->cp()[i];
+    return isFixnum(x) && fixnumVal(x) >= 0 ? fixnumVal(x) : -1;
+}
+
+/*
+  Follow every path through m's code from address 0, and from each handler,
+  tracking the depth of the operand stack above the locals. Throw if an
+  instruction pops more than is there, if paths meet with different depths,
+  or if a path runs off the end of the code or into the middle of an
+  instruction. A handler is entered with the error pushed at the depth the
+  code at the start of its protected range ran at, which is where the VM
+  unwinds to (see HANDLE_ERROR()). Set m's maxStack to the deepest depth
+  any path reaches, VM::fpush() reserves that much once per call so no
+  push needs to check.
+*/
+int verify(FnMethod* m) {
+    const vecu8_t& bc = m->bc();
+    int n = bc.size();
+    std::vector<int> depth(n, -1);
+    std::vector<long> counts(n, -1);
+    std::vector<bool> isInstr(n + 1);
+    for (int a=0; a<n; a+=instrSize(bc.data(), a))
+        isInstr[a] = true;
+    std::vector<int> h;         // (start, end, handler) per handler
+    m->handlerAddrs(h);
+    std::vector<int> work;
+    int maxDepth = 0;
+    auto fail = [m](int addr, const std::string& msg) {
+        std::stringstream ss;
+        ss << "bad bytecode in " << m->fn()->name() << " at "
+           << std::setw(4) << std::hex << std::setfill('0') << addr
+           << ": " << msg;
+        throw SxCompilerError(ss.str());
+    };
+    auto reach = [&](int from, int addr, int d, long count) {
+        if (addr >= n || !isInstr[addr])
+            fail(from, "jump outside of the code");
+        maxDepth = std::max(maxDepth, d);
+        if (depth[addr] < 0) {
+            depth[addr] = d;
+            counts[addr] = count;
+            work.push_back(addr);
+        }
+        else if (depth[addr] != d)
+            fail(addr, "reached with stack depths " + std::to_string(d)
+                 + " and " + std::to_string(depth[addr]));
+        else if (counts[addr] != count)
+            counts[addr] = -1;
+    };
+    if (n)
+        reach(0, 0, 0, -1);
+    while (!work.empty()) {
+        while (!work.empty()) {
+            int a = work.back();
+            work.pop_back();
+            int pops, pushes, d = depth[a];
+            Flow flow = stackEffect(m, a, counts[a], pops, pushes);
+            if (pops > d)
+                fail(a, std::string(opName(bc[a])) + " pops "
+                     + std::to_string(pops) + " at stack depth "
+                     + std::to_string(d));
+            d += pushes - pops;
+            maxDepth = std::max(maxDepth, d);
+            int b = a + instrSize(bc.data(), a);
+            if (flow == NEXT || flow == BRANCH) {
+                if (b >= n)
+                    fail(a, "falls off the end of the code");
+                reach(a, b, d, loadedCount(m, a));
+            }
+            if (flow == GOTO || flow == BRANCH)
+                reach(a, readU16(bc, a + 1), d, -1);
+        }
+        /*
+          A catch is only reached through its handler, so each round enters
+          the handlers whose protected code has been reached. A finally's
+          handler also covers the catches, which start one deeper, with the
+          error on the stack, so it may be entered from a shallower range.
+        */
+        for (size_t i=0; i<h.size(); i+=3) {
+            int start = h[i], addr = h[i + 2];
+            if (start >= n || depth[start] < 0)
+                continue;
+            if (depth[addr] < 0)
+                reach(start, addr, depth[start] + 1, -1);
+            else if (depth[addr] > depth[start] + 1)
+                fail(addr, "handler entered from two stack depths");
+        }
+    }
+    std::vector<int> hdepth;
+    for (size_t i=0; i<h.size(); i+=3)
+        hdepth.push_back(std::max(depth[h[i + 2]] - 1, 0));
+    m->handlerDepths(hdepth);
+    m->maxStack(maxDepth);
+    return maxDepth;
+}
+
 } // end namespace vasm
@@ -27,6 +27,7 @@ enum Opcode {
     LOAD_FREE_B,
     STORE_FREE_0, STORE_FREE_1, STORE_FREE_2, STORE_FREE_3, STORE_FREE_4,
     STORE_FREE_B,
+    LOAD_UPVAL_B, STORE_UPVAL_B,
     NEW_CLOSURE,
     DEF,
     VAR_GET,
@@ -39,7 +40,26 @@ enum Opcode {
     SWAP, SWAP2,
     THROW, RETHROW,
     VAR_SET,                    // 0x68
-    JSR, RET
+    JSR, RET,
+    TAIL_CALL_0, TAIL_CALL_1, TAIL_CALL_2, TAIL_CALL_3, TAIL_CALL_4,
+    TAIL_CALL_B, TAIL_CALL_S,
+    SELF_CALL, TAIL_SELF_CALL,  // see emitSelfCall()
+    // inlined core procs, see emitInlineProc() in compiler.cpp
+    ADD, SUB, MUL, DIV,         // (+ x y) (- x y) (* x y) (/ x y)
+    EQEQ, LT, EQ,               // (== x y) (< x y) (= x y)
+    INC, DEC,                   // (inc x) (dec x), or (+ x 1) (- x 1)
+    NTH,                        // (nth coll i)
+    // quickened forms, only written by the VM, see QUICKEN() in vm.cpp
+    ADD_INT_INT, SUB_INT_INT, LT_INT_INT, EQEQ_INT_INT,
+    INC_INT, DEC_INT,
+    NTH_VECTOR,
+    LT_INT_INT_JUMP_IF_FALSE, EQEQ_INT_INT_JUMP_IF_FALSE,
+    // superinstructions, only emitted by peephole()
+    LOAD_VAR,                   // LOAD_CONST_N VAR_GET
+    LOAD_LOCAL_LOAD_LOCAL,      // LOAD_LOCAL_N LOAD_LOCAL_N
+    LOAD_LOCAL_LOAD_CONST,      // LOAD_LOCAL_N LOAD_CONST_N
+    LT_JUMP_IF_FALSE,           // LT JUMP_IF_FALSE
+    EQEQ_JUMP_IF_FALSE          // EQEQ JUMP_IF_FALSE
 };
 
 enum ProcID {
@@ -58,7 +78,7 @@ enum ProcID {
     TREESET_0N,
     TYPENAME_1,
     EQ_1, EQ_2, EQ_2N,          // (= ...)
-    VM_TRACE_0, VM_STACK_0,
+    VM_TRACE_0, VM_STACK_0, VM_STATS_0, VM_STATS_PRINT_0, GC_BYTES_0,
     COMPILE_1,
     IDENTICAL_P_2,
     META_1, WITH_META_2,
@@ -106,6 +126,7 @@ enum ProcID {
     // 
     PUSH_BINDINGS_1, POP_BINDINGS_0,
     MACROEXPAND_1_1,
+    IR_1,
     // interface predicates
     SEQ_P_1,
     SEQABLE_P_1,
@@ -154,10 +175,22 @@ enum ProcID {
     DIV_1, DIV_2, DIV_2N,        // (/ ...)
     EQEQ_1, EQEQ_2, EQEQ_2N,     // (== ...)
     LT_1, LT_2, LT_2N,           // (< ...)
+    INC_1, DEC_1,
+    PROC_ID_END                  // one past the last id, sizes VM dispatch
 };
 
+// NEW_CLOSURE capture flags
+enum {
+    CAPTURE_LOCAL = 1,          // index is a local, else an enclosing free var
+    CAPTURE_BOXED = 2           // share it through an Upval, else copy it
+};
+
+const char* opName(int id);
 int disOne(const FnMethod* m, int addr, std::ostream& s=std::cout);
 void dis(const FnMethod* m, std::ostream& s=std::cout);
+int instrSize(const uint8_t* code, int addr);
+void peephole(FnMethod* m);
+int verify(FnMethod* m);
 
 
 } // end namespace vasm
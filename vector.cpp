@@ -11,41 +11,69 @@ Vector* Vector::create() {
 }
 
 Vector* Vector::create(const vecobj_t& v) {
-    return new Vector(v);
+    return create(VecTrie(v));
+}
+
+Vector* Vector::create(const VecTrie& v) {
+    Vector* p = new Vector();
+    p->_impl = v;
+    return p;
 }
 
 // ctors
 
-Vector::Vector() : Fn("SxVector"), _impl() {
-    _typeName = "SxVector";
+Vector::Vector()
+    : Fn("SxVector"), _impl(), _meta(nullptr), _edit(nullptr) {
+    _typeId = TID_Vector;
     createMethods();
 }
 
-Vector::Vector(const vecobj_t& v) : Fn("SxVector"), _impl(v) {
-    _typeName = "SxVector";
-    createMethods();
+// a transient copy of this vector, it shares the VecTrie until it changes
+Vector* Vector::transient() {
+    Vector* v = create(_impl);
+    v->_edit = v;
+    return v;
 }
 
-// 
+// stop changing in place, this is then an ordinary vector
+Vector* Vector::persistent() {
+    _edit = nullptr;
+    return this;
+}
+
+// a new vector of impl, with this vector's meta
+Vector* Vector::with(const VecTrie& impl) {
+    Vector* v = create(impl);
+    v->_meta = _meta;
+    return v;
+}
 
+// Every vector shares the methods of one Fn, as every Hashmap does
 void Vector::createMethods() {
+    static Fn* fn = nullptr;
+    if (fn) {
+        shareMethods(fn);
+        return;
+    }
+    fn = Fn::create("SxVector");
     // ([] i)
-    FnMethod* m = addMethod(false, 1);
+    FnMethod* m = fn->addMethod(false, 1);
     m->nLocals(2);            // this, index
     m->appendByte(vasm::CALL_PROC);
     m->appendByte(static_cast<uint8_t>(vasm::NTH_2));
     m->appendByte(static_cast<uint8_t>(vasm::NTH_2 >> 8));
     m->appendByte(vasm::RETURN);
     // ([] i not-found)
-    m = addMethod(false, 2);
+    m = fn->addMethod(false, 2);
     m->nLocals(3);            // this, index, notFound
     m->appendByte(vasm::CALL_PROC);
     m->appendByte(static_cast<uint8_t>(vasm::NTH_3));
     m->appendByte(static_cast<uint8_t>(vasm::NTH_3 >> 8));
     m->appendByte(vasm::RETURN);
+    shareMethods(fn);
 }
 
-const vecobj_t& Vector::impl() const {
+const VecTrie& Vector::impl() const {
     return _impl;
 }
 
@@ -55,10 +83,9 @@ const vecobj_t& Vector::impl() const {
 std::string Vector::toString() {
     std::stringstream ss;
     ss << '[';
-    size_t n = _impl.size();
-    for (size_t i=0; i<n; ++i) {
-        ss << rt::toString(_impl[i]);
-        if (i < n-1)
+    for (auto itr=_impl.begin(); itr!=_impl.end();) {
+        ss << rt::toString(*itr);
+        if (++itr != _impl.end())
             ss << ' ';
     }
     ss << ']';
@@ -67,14 +94,14 @@ std::string Vector::toString() {
 
 size_t Vector::getHash() {
     std::stringstream ss;
-    ss << _typeName << " is not hashable";
+    ss << typeName() << " is not hashable";
     throw SxRuntimeError(ss.str());
 }
 
 bool Vector::isEqualTo(Obj* obj) {
     if (this == obj)
         return true;
-    else if (Vector* v = dynamic_cast<Vector*>(obj)) {
+    else if (Vector* v = pVector(obj)) {
         if (count() == v->count())
             return std::equal(_impl.begin(), _impl.end(), v->_impl.begin(),
                               objEqual);
@@ -87,6 +114,10 @@ bool Vector::isEqualTo(Obj* obj) {
                 return false;
         return i == count() && !s; // all compared
     }
+    else if (ArgSeq* p = pArgSeq(obj))
+        return p->isEqualTo(this);
+    else if (ASeq* p = pASeq(obj))
+        return p->isEqualTo(this);
     else if (MapEntry* p = pMapEntry(obj)) {
         return count() == 2
             && rt::isEqualTo(nth(0), p->key())
@@ -101,29 +132,23 @@ bool Vector::isEqualTo(Obj* obj) {
 ISeq* Vector::seq() {
     if (_impl.empty())
         return NIL;
-    ISeq* ret = NIL;
-    for (auto itr=_impl.crbegin(); itr!=_impl.crend(); ++itr)
-        ret = rt::cons(ret, *itr);
-    return ret;
+    return VectorSeq::create(this);
 }
 
 // =========================================================================
 // IIndexed
 
 Obj* Vector::nth(int i) {
-    if (i >= 0)
-        for (int j=0; j<(int)_impl.size(); ++j)
-            if (j == i)
-                return _impl[i];
+    if (i >= 0 && i < count())
+        return _impl[i];
     std::stringstream ss;
-    ss << _typeName << " index (" << i << ") out of bounds";
+    ss << typeName() << " index (" << i << ") out of bounds";
     throw SxOutOfBoundsError(ss.str());
 }
 
 Obj* Vector::nth(int i, Obj* notFound) {
-    for (int j=0; j<(int)_impl.size(); ++j)
-        if (j == i)
-            return _impl[i];
+    if (i >= 0 && i < count())
+        return _impl[i];
     return notFound;
 }
 
@@ -139,6 +164,74 @@ bool Vector::isEmpty() {
 }
 
 ICollection* Vector::conj(Obj* obj) {
-    _impl.push_back(obj);
-    return this;
+    if (_edit) {
+        _impl.push_back(obj, _edit);
+        return this;
+    }
+    VecTrie impl = _impl;
+    impl.push_back(obj);
+    return with(impl);
+}
+
+// =========================================================================
+// IAssociative
+
+// true if key is an index of this vector, in i
+bool Vector::indexOf(Obj* key, size_t& i) {
+    if (INumber* p = pINumber(key)) {
+        long n = p->toInt();
+        if (n >= 0 && n < count()) {
+            i = n;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ([a b] 2 c) conjs c, as Clojure's assoc does
+IAssociative* Vector::assoc(Obj* key, Obj* val) {
+    size_t i;
+    if (!indexOf(key, i)) {
+        INumber* p = pINumber(key);
+        if (p && p->toInt() == count())
+            return pVector(conj(val));
+        std::stringstream ss;
+        ss << typeName() << " index (" << rt::toString(key)
+           << ") out of bounds";
+        throw SxOutOfBoundsError(ss.str());
+    }
+    if (_edit) {
+        _impl.set(i, val, _edit);
+        return this;
+    }
+    if (_impl[i] == val)
+        return this;
+    VecTrie impl = _impl;
+    impl.set(i, val);
+    return with(impl);
+}
+
+IAssociative* Vector::dissoc(Obj*) {
+    std::stringstream ss;
+    ss << "can't dissoc from a " << typeName();
+    throw SxNotImplementedError(ss.str());
+}
+
+bool Vector::hasKey(Obj* key) {
+    size_t i;
+    return indexOf(key, i);
+}
+
+MapEntry* Vector::entryAt(Obj* key) {
+    size_t i;
+    if (indexOf(key, i))
+        return MapEntry::create(key, _impl[i]);
+    return NIL;
+}
+
+Obj* Vector::valAt(Obj* key, Obj* notFound) {
+    size_t i;
+    if (indexOf(key, i))
+        return _impl[i];
+    return notFound;
 }
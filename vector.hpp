@@ -13,11 +13,24 @@
  ([1 2 3] 1)             => 2
  ([1 2 3] 42)            => throw
  ([1 2 3] 42 :not-found) => :not-found
+
+ Persistent, conj() and assoc() return a new vector that shares most of its
+ VecTrie with the original. A transient vector changes in place, as a
+ transient Hashmap does:
+
+   Vector* v = Vector::create()->transient();
+   ...
+   v->conj(x);
+   ...
+   return v->persistent();
  */
-struct Vector : Fn, ISeqable, IIndexed, ICollection, IMeta {
+struct Vector : Fn, ISeqable, IIndexed, ICollection, IAssociative, IMeta {
     static Vector* create();
     static Vector* create(const vecobj_t&);
-    const vecobj_t& impl() const;
+    static Vector* create(const VecTrie&);
+    const VecTrie& impl() const;
+    Vector* transient();
+    Vector* persistent();
     static vecu8_t _bc;
     //
     std::string toString();
@@ -33,15 +46,23 @@ struct Vector : Fn, ISeqable, IIndexed, ICollection, IMeta {
     int count();
     bool isEmpty();
     ICollection* conj(Obj*);
+    // IAssociative, the keys are the indices
+    IAssociative* assoc(Obj*, Obj*);
+    IAssociative* dissoc(Obj*);
+    bool hasKey(Obj*);
+    MapEntry* entryAt(Obj*);
+    Obj* valAt(Obj* key, Obj* notFound=NIL);
     // 
     Hashmap* meta() { return _meta; }
     Obj* withMeta(Hashmap* m) { _meta = m; return this; }
 protected:    
-    vecobj_t _impl;
+    VecTrie _impl;
     Hashmap* _meta;
+    const void* _edit;          // the transient's owner token, or nullptr
     void createMethods();
     Vector();
-    Vector(const vecobj_t&);
+    Vector* with(const VecTrie&);
+    bool indexOf(Obj* key, size_t& i);
 };
 DEF_CASTER(Vector)
 
@@ -0,0 +1,132 @@
+/*
+  vectrie.cpp
+  S. Edward Dolan
+  Saturday, October 17 2026
+*/
+
+#include "sxp.hpp"
+
+namespace {
+
+/*
+  The owner token of a VecTrie being built from a vecobj_t. Only ever used
+  on the new trie's own nodes, so the one token serves every build.
+*/
+const char BUILDING = 0;
+
+VecTrieNode* newNode(uint32_t cap, const void* edit) {
+    size_t words = sizeof(VecTrieNode) / sizeof(Obj*) + cap;
+    Obj** mem = gc_allocator<Obj*>().allocate(words);
+    std::fill(mem, mem + words, nullptr);
+    VecTrieNode* n = reinterpret_cast<VecTrieNode*>(mem);
+    n->edit = edit;
+    n->cap = cap;
+    return n;
+}
+
+// n itself if it belongs to edit, else a copy of n with room for cap slots
+VecTrieNode* editable(VecTrieNode* n, uint32_t cap, const void* edit) {
+    if (edit && n->edit == edit && n->cap >= cap)
+        return n;
+    VecTrieNode* m = newNode(cap, edit);
+    std::copy(n->slots(), n->slots() + std::min(cap, n->cap), m->slots());
+    return m;
+}
+
+// a chain of nodes from level down to node
+VecTrieNode* newPath(int level, VecTrieNode* node, const void* edit) {
+    if (!level)
+        return node;
+    VecTrieNode* n = newNode(32, edit);
+    n->child(0) = newPath(level - 5, node, edit);
+    return n;
+}
+
+// the full leaf becomes the last leaf of the trie, which holds cnt elements
+VecTrieNode* pushLeaf(size_t cnt, int level, VecTrieNode* parent,
+                      VecTrieNode* leaf, const void* edit) {
+    int i = ((cnt - 1) >> level) & 31;
+    VecTrieNode* n = editable(parent, 32, edit);
+    if (level == 5)
+        n->child(i) = leaf;
+    else if (VecTrieNode* child = parent->child(i))
+        n->child(i) = pushLeaf(cnt, level - 5, child, leaf, edit);
+    else
+        n->child(i) = newPath(level - 5, leaf, edit);
+    return n;
+}
+
+VecTrieNode* set(int level, VecTrieNode* node, size_t i, Obj* x,
+                 const void* edit) {
+    VecTrieNode* n = editable(node, 32, edit);
+    if (!level)
+        n->slots()[i & 31] = x;
+    else {
+        int j = (i >> level) & 31;
+        n->child(j) = set(level - 5, node->child(j), i, x, edit);
+    }
+    return n;
+}
+
+} // namespace
+
+// =========================================================================
+
+VecTrie::VecTrie(const vecobj_t& v) : VecTrie() {
+    for (auto x : v)
+        push_back(x, &BUILDING);
+    // trim the tail to fit, like the one of a persistent push_back()
+    size_t tailLen = _cnt - tailOffset();
+    if (_tail && _tail->cap > tailLen)
+        _tail = editable(_tail, tailLen, nullptr);
+}
+
+Obj** VecTrie::leafFor(size_t i) const {
+    if (i >= tailOffset())
+        return _tail->slots();
+    VecTrieNode* n = _root;
+    for (int level=_shift; level>0; level-=5)
+        n = n->child((i >> level) & 31);
+    return n->slots();
+}
+
+/*
+  A transient's tail has room for 32 elements, a persistent one is copied
+  one larger on each push.
+*/
+void VecTrie::push_back(Obj* x, const void* edit) {
+    size_t tailLen = _cnt - tailOffset();
+    if (!_tail || tailLen < 32) {
+        _tail = _tail ? editable(_tail, edit ? 32 : tailLen + 1, edit)
+                      : newNode(edit ? 32 : 1, edit);
+        _tail->slots()[tailLen] = x;
+        ++_cnt;
+        return;
+    }
+    // the tail is full, it becomes the trie's last leaf
+    if (!_root)
+        _root = newNode(32, edit);
+    if ((_cnt >> 5) > (size_t(1) << _shift)) {
+        // the root is full too, the trie grows a level
+        VecTrieNode* root = newNode(32, edit);
+        root->child(0) = _root;
+        root->child(1) = newPath(_shift, _tail, edit);
+        _root = root;
+        _shift += 5;
+    }
+    else
+        _root = pushLeaf(_cnt, _shift, _root, _tail, edit);
+    _tail = newNode(edit ? 32 : 1, edit);
+    _tail->slots()[0] = x;
+    ++_cnt;
+}
+
+// i must be < size()
+void VecTrie::set(size_t i, Obj* x, const void* edit) {
+    if (i >= tailOffset()) {
+        _tail = editable(_tail, _tail->cap, edit);
+        _tail->slots()[i & 31] = x;
+    }
+    else
+        _root = ::set(_shift, _root, i, x, edit);
+}
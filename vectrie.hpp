@@ -0,0 +1,73 @@
+/*
+  vectrie.hpp
+  S. Edward Dolan
+  Saturday, October 17 2026
+*/
+
+#ifndef VECTRIE_HPP_INCLUDED
+#define VECTRIE_HPP_INCLUDED
+
+// A node of a VecTrie, its slots follow it in the same allocation
+struct VecTrieNode {
+    const void* edit;           // the transient that may change it in place
+    uint32_t cap;               // number of slots
+    Obj** slots() { return reinterpret_cast<Obj**>(this + 1); }
+    VecTrieNode*& child(int i) {
+        return reinterpret_cast<VecTrieNode**>(this + 1)[i];
+    }
+};
+
+/*
+  A persistent bit-partitioned vector trie, the impl of Vector. Elements
+  live in 32 slot leaves under a trie of 32-way nodes, 5 bits of an index
+  per level, so nth() and set() are O(log32 n). The last, partial leaf is
+  kept out of the trie as the tail, so push_back() only touches the trie
+  once every 32 elements.
+
+  Changes make new nodes along the index's path and share the rest with
+  the original. A non-null edit is a transient's owner token, as in Hamt.
+*/
+struct VecTrie {
+    VecTrie() : _cnt(0), _shift(5), _root(nullptr), _tail(nullptr) {}
+    VecTrie(const vecobj_t&);
+    size_t size() const { return _cnt; }
+    bool empty() const { return !_cnt; }
+    Obj* operator[](size_t i) const { return leafFor(i)[i & 31]; }
+    void push_back(Obj* x, const void* edit = nullptr);
+    void set(size_t i, Obj* x, const void* edit = nullptr);
+    vecobj_t vec() const { return vecobj_t(begin(), end()); }
+    // the leaf that holds element i, in its slot i & 31
+    Obj** leafFor(size_t i) const;
+    // walks one leaf at a time
+    struct iterator {
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Obj* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Obj* const* pointer;
+        typedef Obj* const& reference;
+        iterator(const VecTrie* v, size_t i)
+            : _v(v), _i(i), _leaf(i < v->_cnt ? v->leafFor(i) : nullptr) {}
+        Obj* const& operator*() const { return _leaf[_i & 31]; }
+        iterator& operator++() {
+            if (!(++_i & 31) && _i < _v->_cnt)
+                _leaf = _v->leafFor(_i);
+            return *this;
+        }
+        bool operator==(const iterator& x) const { return _i == x._i; }
+        bool operator!=(const iterator& x) const { return _i != x._i; }
+    protected:
+        const VecTrie* _v;
+        size_t _i;
+        Obj** _leaf;
+    };
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, _cnt); }
+protected:
+    size_t _cnt;
+    int _shift;                 // of the root's level
+    VecTrieNode* _root;         // nullptr until the first leaf is full
+    VecTrieNode* _tail;
+    size_t tailOffset() const { return _cnt < 32 ? 0 : (_cnt - 1) & ~31; }
+};
+
+#endif // VECTRIE_HPP_INCLUDED
@@ -6,89 +6,227 @@
 
 #include "sxp.hpp"
 
-struct Frame : gc {
-    const Fn* fn;            // method's parent function
-    const FnMethod* method;  // method currently being executed
-    const vecu8_t& bc;       // method's bytecode
-    const vecobj_t& cp;      // fn's constant pool
-    Obj** locals;            // pstack address of fn
-    uint16_t retAddr;        // the addr of the next instruction of the caller
-    Closure* closure;
-    int fnIndex;                // pstack index of this frame's function
-    Frame(const FnMethod* method, Obj** locals, uint16_t retAddr,
-          Closure* closure, int fnIndex)
-        : fn(method->fn()),
-          method(method),
-          bc(method->bc()),
-          cp(method->fn()->cp()),
-          locals(locals),
-          retAddr(retAddr),
-          closure(closure),
-          fnIndex(fnIndex) { 
-    }
-};
-
-// =========================================================================
+VMStats VM::_stats = {};
 
-long VM::_nInstructions = 0;
+void VMStats::print(std::ostream& out) const {
+    std::stringstream s;        // leave out's format flags alone
+    s << "\nVM instructions executed: " << rt::commify(nInstructions)
+      << std::endl;
+    std::vector<int> ids;
+    for (int i=0; i<vasm::PROC_ID_END; ++i)
+        if (opcodes[i])
+            ids.push_back(i);
+    std::sort(ids.begin(), ids.end(), [this](int a, int b) {
+        return opcodes[a] > opcodes[b];
+    });
+    for (int id : ids)
+        s << std::setw(16) << rt::commify(opcodes[id]) << " "
+          << std::setw(5) << std::fixed << std::setprecision(1)
+          << 100.0 * opcodes[id] / nInstructions << "% "
+          << vasm::opName(id) << std::endl;
+    // the opcode pairs worth fusing, see vasm::peephole()
+    std::vector<std::pair<int, int>> ps;
+    for (int i=0; i<256; ++i)
+        for (int j=0; j<256; ++j)
+            if (pairs[i][j])
+                ps.push_back({i, j});
+    std::sort(ps.begin(), ps.end(), [this](auto a, auto b) {
+        return pairs[a.first][a.second] > pairs[b.first][b.second];
+    });
+    if (ps.size() > 20)
+        ps.resize(20);
+    if (!ps.empty())
+        s << "top opcode pairs:" << std::endl;
+    for (auto p : ps)
+        s << std::setw(16) << rt::commify(pairs[p.first][p.second]) << " "
+          << vasm::opName(p.first) << " " << vasm::opName(p.second)
+          << std::endl;
+    bool any = false;
+    for (int i=0; i<256; ++i)
+        if (quickened[i] || deopts[i]) {
+            if (!any)
+                s << "quickened instructions:" << std::endl;
+            any = true;
+            s << std::setw(16) << rt::commify(quickened[i]) << " "
+              << vasm::opName(i) << " (" << rt::commify(deopts[i])
+              << " deoptimized)" << std::endl;
+        }
+    if (long n = icHits + icMisses)
+        s << "call site cache hits: " << rt::commify(icHits) << " of "
+          << rt::commify(n) << " (" << std::fixed << std::setprecision(1)
+          << 100.0 * icHits / n << "%)" << std::endl;
+    if (closures)
+        s << "closures allocated: " << rt::commify(closures) << " ("
+          << rt::commify(closureVals) << " values copied, "
+          << rt::commify(closureUpvals) << " upvals)" << std::endl;
+    out << s.str();
+}
 
 VM::VM()
     : pc(0),
-      pstack(),
+      pstack(gc_allocator<Obj*>().allocate(INIT_PSTACK_SIZE)),
+      sp(pstack),
+      pstackEnd(pstack + INIT_PSTACK_SIZE),
       curFrame(nullptr),
-      fstack(),
+      fstack(INIT_FSTACK_SIZE),
+      fsp(0),
       openUpvals(nullptr),
+      openArgs(nullptr),
+      procArgs(ArgSeq::create(nullptr, 0)),
       jstack() {
-    pstack.reserve(MAX_PSTACK_SIZE);
-    rt::pushVM(this);
 }
 
-VM::~VM() {
+// =========================================================================
+// VM pool
+
+std::vector<VM*, gc_allocator<VM*>> VM::_pool;
+
+/*
+  Borrow an idle VM, or make one if they're all busy. The pool only ever
+  grows to the deepest nesting of loadFile(), macroExpand1() and
+  LazySeq::sval() seen so far. VMs are allocated in the collected heap so
+  their stacks are scanned.
+*/
+VM* VM::acquire() {
+    VM* vm;
+    if (_pool.empty())
+        vm = new (UseGC) VM();
+    else {
+        vm = _pool.back();
+        _pool.pop_back();
+    }
+    rt::pushVM(vm);
+    return vm;
+}
+
+void VM::release(VM* vm) {
     rt::popVM();
+    vm->reset();
+    _pool.push_back(vm);
 }
 
+// =========================================================================
+
 void VM::reset() {
     pc = 0;
-    pstack.clear();
+    sp = pstack;
     curFrame = nullptr;
     openUpvals = nullptr;
-    fstack.clear();
+    closeArgs(pstack);          // a throw out of run() may leave some open
+    fsp = 0;
 }
 
-void VM::ppush(Obj* x) {
-    pstack.push_back(x);
+/*
+  The pushes don't check for room, VM::fpush() reserved enough for the
+  deepest the frame's operand stack goes (see vasm::verify()). Build with
+  -DSXP_CHECK_STACK to check every push against that depth anyway.
+*/
+__attribute__((always_inline)) inline void VM::ppush(Obj* x) {
+#ifdef SXP_CHECK_STACK
+    if (curFrame && sp >= curFrame->locals + curFrame->method->nLocals()
+        + curFrame->method->maxStack())
+        throw SxRuntimeError("operand stack of " + curFrame->fn->name()
+                             + " is deeper than its verified depth");
+#endif
+    *sp++ = x;
 }
 
 Obj* VM::ppop() {
-    Obj* x = pstack.back();
-    pstack.pop_back();
-    return x;
+    return *--sp;
 }
 
 // i=0 is the top of the stack, i=1 is next obj down, etc.
 Obj* VM::ppeek(int i) {
-    return pstack[pstack.size() - 1 - i];
+    return sp[-1 - i];
+}
+
+// resize the stack to n slots, new slots are nil
+void VM::presize(size_t n) {
+    reserve(n);
+    Obj** top = pstack + n;
+    while (sp < top)
+        *sp++ = NIL;
+    sp = top;
+}
+
+// make room for n slots
+void VM::reserve(size_t n) {
+    if (__builtin_expect(pstack + n > pstackEnd, 0))
+        growPstack(n);
 }
 
 /*
-  nArgs is the number of args on the stack after accumulating any & rest args
-  into a list.
- */
-void VM::fpush(FnMethod* method, int nArgs, int retAddr,
-               Closure* closure = nullptr ) {
-    int fnIndex = pstack.size() - nArgs - 1; // stack index of called fn
-    Obj** locals = &pstack[fnIndex]; // ???
-    // add nil's for the method's locals (the fn is at locals[0])
-    size_t newSize = pstack.size() + method->nLocals() - nArgs - 1;
-    if (newSize > MAX_PSTACK_SIZE) {
+  pstack starts small and doubles as needed up to MAX_PSTACK_SIZE, which is
+  the guard against runaway recursion. Frame locals, open upvals, and rest
+  args hold raw addresses into it, so they are rebased when it moves.
+*/
+void VM::growPstack(size_t minSize) {
+    if (minSize > MAX_PSTACK_SIZE) {
         std::stringstream ss;
         ss << "max VM parameter stack size (" << MAX_PSTACK_SIZE
            << ") exceeded";
         throw SxRuntimeError(ss.str());
     }
-    pstack.resize(newSize);
-    fstack.push_back(curFrame = new Frame(method, locals, retAddr, closure,
-                                          fnIndex));
+    size_t size = std::max(minSize, std::min(2 * size_t(pstackEnd - pstack),
+                                             size_t(MAX_PSTACK_SIZE)));
+    Obj** oldBase = pstack;
+    Obj** newBase = gc_allocator<Obj*>().allocate(size);
+    std::copy(oldBase, sp, newBase);
+    pstack = newBase;
+    sp = newBase + (sp - oldBase);
+    pstackEnd = newBase + size;
+    for (int i=0; i<fsp; ++i)
+        fstack[i].locals = newBase + (fstack[i].locals - oldBase);
+    for (Upval* v=openUpvals; v; v=v->next)
+        v->addr = newBase + (v->addr - oldBase);
+    for (ArgSeq* a=openArgs; a; a=a->_nextOpen)
+        a->_args = newBase + (a->_args - oldBase);
+    if (procArgs->_args)
+        procArgs->_args = newBase + (procArgs->_args - oldBase);
+}
+
+/*
+  nArgs is the number of args on the stack after accumulating any & rest args
+  into an ArgSeq. nBelow is the number of slots under the fn that the frame
+  owns, the tail args of its rest arg (see doCall()).
+ */
+void VM::fpush(FnMethod* method, int nArgs, int retAddr,
+               Closure* closure = nullptr, int nBelow = 0) {
+    int localsIndex = pdepth() - nArgs - 1; // stack index of called fn
+    int fnIndex = localsIndex - nBelow;
+    /*
+      The one check for room in the frame: its locals, its operand stack,
+      and the nil doCall() may push for an empty rest arg of a call from it.
+    */
+    reserve(localsIndex + method->nLocals() + method->maxStack() + 1);
+    // add nil's for the method's locals (the fn is at locals[0])
+    presize(localsIndex + method->nLocals());
+    Obj** locals = pstack + localsIndex; // reserve() may have moved pstack
+    /*
+      fstack only grows, doubling when full, and its slots are overwritten in
+      place, so after warming up a call costs no allocation. Growing moves
+      the frames, which is fine as long as nothing but curFrame points at one
+      across a call.
+    */
+    if (fsp == static_cast<int>(fstack.size())) {
+        if (fsp >= MAX_FSTACK_SIZE) {
+            std::stringstream ss;
+            ss << "max VM frame stack depth (" << MAX_FSTACK_SIZE
+               << ") exceeded";
+            throw SxRuntimeError(ss.str());
+        }
+        fstack.resize(2 * fsp);
+    }
+    Frame* f = curFrame = &fstack[fsp++];
+    f->fn = method->fn();
+    f->method = method;
+    f->code = method->bc().data();
+    f->cp = f->fn->cp().data();
+    f->locals = locals;
+    f->retAddr = retAddr;
+    f->closure = closure;
+    f->fnIndex = fnIndex;
+    f->ic = method->callCaches();
     pc = 0;
 }
 
@@ -96,66 +234,126 @@ int VM::fpop(bool isThrow) {
     if (!isThrow)
         if (openUpvals)
             closeUpvals(curFrame->locals);
-    Frame* f = fstack.back();   // get a ref to this frame
-    fstack.pop_back();          // pop this frame
-    if (fstack.empty())
+    Frame* f = curFrame;        // get a ref to this frame
+    if (openArgs)
+        closeArgs(pstack + f->fnIndex);
+    --fsp;                      // pop this frame, its slot stays valid
+    if (!fsp)
         /*
           The last frame was popped, leave the result of this fn call on the
           stack.
         */
         return true; 
     pc = f->retAddr;            // reset the pc for the caller of this fn
-    Obj* x = pstack.back();     // grab the result from this fn call
-    pstack.resize(f->fnIndex);  // pop this fn and everything after it
+    Obj* x = sp[-1];            // grab the result from this fn call
+    sp = pstack + f->fnIndex;   // pop this fn and everything after it
     ppush(x);                   // push the result for the caller
-    curFrame = fstack.back();   // reset the current frame
+    curFrame = &fstack[fsp - 1]; // reset the current frame
     return false;
 }
 
 /*
-  nArgs here is how many arguments the fn was called with. This differs from
-  the nArgs parameter in VM::fpush().
+  Replace the current frame with a call to the fn under the nArgs args on
+  top of the stack (see TAIL_CALL_N). Any of the frame's locals captured by
+  a closure, and its rest arg, are closed first, then the fn and its args
+  slide down over the frame's fn and locals. Return the frame's return address, the caller
+  then fpush()es into the same fstack slot.
 */
-void VM::doCall(Obj* callable, int nArgs) {
-    Fn* fn = (pClosure(callable) ?
-              pClosure(callable)->fn :
-              cpFn(callable)); // may throw
-    FnMethod* m = fn->getMethod(nArgs);
-    if (!m) {
-        std::stringstream ss;
-        ss << "wrong number of args (" << nArgs << ") passed to: "
-           << fn->name();
-        throw SxRuntimeError(ss.str());
+int VM::dropFrame(int nArgs) {
+    Frame* f = curFrame;
+    if (openUpvals)
+        closeUpvals(f->locals);
+    if (openArgs)
+        closeArgs(pstack + f->fnIndex);
+    std::copy(sp - nArgs - 1, sp, pstack + f->fnIndex);
+    sp = pstack + f->fnIndex + nArgs + 1;
+    --fsp;
+    return f->retAddr;
+}
+
+/*
+  Call callable with the nArgs args on top of the stack. nArgs here is how
+  many arguments the fn was called with. This differs from the nArgs
+  parameter in VM::fpush(). ic is the calling instruction's CallCache, or
+  nullptr if it doesn't have one. On a hit the method is known without
+  looking at the Fn at all. isTail reuses the current frame.
+*/
+template <bool INSTRUMENTED>
+void VM::doCall(Obj* callable, int nArgs, CallCache* ic, bool isTail) {
+    Closure* closure = pClosure(callable);
+    Obj* callee = closure ? closure->fn : callable;
+    FnMethod* m;
+    if (ic && ic->callee == callee && ic->method) {
+        m = ic->method;
+        if (INSTRUMENTED && rt::vmStats)
+            ++_stats.icHits;
     }
-    if (!m->isRest())
-        fpush(m, nArgs, pc, pClosure(callable));
     else {
-        // rest method with no tail args
-        if (m->reqArgs() == nArgs) {
-            ppush(NIL);
-            fpush(m, nArgs + 1, pc, pClosure(callable));
+        Fn* fn = closure ? closure->fn : cpFn(callable); // may throw
+        m = fn->getMethod(nArgs);
+        if (!m) {
+            std::stringstream ss;
+            ss << "wrong number of args (" << nArgs << ") passed to: "
+               << fn->name();
+            throw SxRuntimeError(ss.str());
         }
-        else {
-            // rest method with tail args
-            int nTailArgs = nArgs - m->reqArgs();
-            ISeq* tail = List::create(ppop());
-            while (--nTailArgs)
-                tail = rt::cons(tail, ppop());
-            ppush(tail);
-            fpush(m, m->reqArgs() + 1, pc, pClosure(callable));
+        if (ic) {
+            ic->callee = callee;
+            ic->method = m;
+            if (INSTRUMENTED && rt::vmStats)
+                ++_stats.icMisses;
         }
     }
+    int retAddr = isTail ? dropFrame(nArgs) : pc;
+    if (!m->isRest()) {
+        fpush(m, nArgs, retAddr, closure);
+        return;
+    }
+    int nTail = nArgs - m->reqArgs();
+    if (!nTail) {
+        *sp++ = NIL;            // the slot fpush() left for it
+        fpush(m, nArgs + 1, retAddr, closure);
+        return;
+    }
+    /*
+      The tail args stay where the caller pushed them. The fn and its
+      required args are copied above them, followed by an ArgSeq over them,
+      and the frame pops to the fn's original slot:
+
+        ... fn r1 r2 t1 t2 t3 fn r1 r2 (t1 t2 t3)]
+
+      A Proc can't let its rest arg escape, so every Proc call reuses
+      procArgs. Any other fn gets its own ArgSeq, which is close()d when the
+      frame is left.
+    */
+    int nFixed = m->reqArgs() + 1;
+    reserve(pdepth() + nFixed + 1);
+    Obj** tail = sp - nTail;
+    sp = std::copy(tail - nFixed, tail, sp);
+    ArgSeq* rest;
+    if (pProc(callee)) {
+        rest = procArgs;
+        rest->_args = tail;
+        rest->_n = nTail;
+    }
+    else {
+        rest = new ArgSeq(tail, nTail);
+        rest->_nextOpen = openArgs;
+        openArgs = rest;
+    }
+    *sp++ = rest;
+    fpush(m, nFixed, retAddr, closure, nTail + nFixed);
 }
 
 // sxp function: (vm-stack)
 void VM::printStack(std::ostream& stream=std::cout) {
-    if (!pstack.empty()) {
+    if (sp != pstack) {
         size_t i = 0, maxLen = 73; // stack object max toString() length
         stream << "> ";
-        for (auto itr=pstack.rbegin(); itr!= pstack.rend(); ++itr) {
+        for (Obj** itr=sp; itr!=pstack; ) {
             if (i++)
                 stream << "  ";
-            const std::string& s = rt::toString(*itr);
+            const std::string& s = rt::toString(*--itr);
             stream << (s.size() > maxLen ? s.substr(0, maxLen) + "..." : s)
                    << std::endl;
         }
@@ -195,47 +393,285 @@ void VM::closeUpvals(Obj** lastAddr) {
         //           << std::endl;
     }
 }
-// read and return a 16 bit unsigned int at the current pc
-#define READ_U16() (curFrame->bc[pc] | curFrame->bc[pc + 1] << 8)
 
-// jump to a case label in VM::run()
+// the same as closeUpvals() for the rest args of the frames being left
+void VM::closeArgs(Obj** lastAddr) {
+    while (openArgs && openArgs->_args >= lastAddr) {
+        ArgSeq* a = openArgs;
+        a->close();
+        openArgs = a->_nextOpen;
+        a->_nextOpen = nullptr;
+    }
+}
+
+/*
+  Instruction dispatch. With GCC (or anything else that has labels as
+  values) VM::exec() is direct-threaded: each instruction body ends by jumping
+  through a table of label addresses straight to the body of the next
+  opcode. Building with -DSXP_SWITCH_DISPATCH selects the portable switch
+  loop instead. Either way the instruction bodies read their operands
+  through ip, a raw pointer into the current method's bytecode. The pc
+  member is only synced with ip when something outside of VM::exec() needs
+  it: calls, returns, traces, and error handling.
+*/
+#if defined(__GNUC__) && !defined(SXP_SWITCH_DISPATCH)
+#define SXP_THREADED_DISPATCH
+#pragma GCC diagnostic ignored "-Wpedantic" // &&label is a GNU extension
+#endif
+
+// read and return a 16 bit unsigned int at ip
+#define READ_U16() (ip[0] | ip[1] << 8)
+
+// sync pc from ip, and ip from pc
+#define SAVE_PC() (pc = ip - curFrame->code)
+#define LOAD_IP() (ip = curFrame->code + pc)
+
+// the instrumented loop's instruction and opcode pair counts
+#define COUNT(oc) do {                                  \
+        if (INSTRUMENTED && rt::vmStats) {              \
+            ++_stats.nInstructions;                     \
+            ++_stats.opcodes[oc];                       \
+            if (oc < 256) {                             \
+                ++_stats.pairs[prevOc][oc];             \
+                prevOc = oc;                            \
+            }                                           \
+        }                                               \
+    } while(0)
+
+/*
+  Quickening. A generic instruction that sees operands of the type its
+  specialized form handles rewrites its own opcode in the method's bytecode,
+  ip just past it, so the next execution runs the specialized form. When the
+  specialized form's type guard fails it rewrites the opcode back with
+  DEOPT() and does the generic work. Build with -DSXP_NO_QUICKEN to leave
+  the bytecode alone.
+*/
+#ifdef SXP_NO_QUICKEN
+#define QUICKEN(id) do {} while(0)
+#else
+#define QUICKEN(id) do {                                \
+        const_cast<uint8_t*>(ip)[-1] = vasm::id;        \
+        if (INSTRUMENTED && rt::vmStats)                \
+            ++_stats.quickened[vasm::id];               \
+    } while(0)
+#endif
+#define DEOPT(id) do {                                  \
+        if (INSTRUMENTED && rt::vmStats)                \
+            ++_stats.deopts[ip[-1]];                    \
+        const_cast<uint8_t*>(ip)[-1] = vasm::id;        \
+    } while(0)
+
+// call a fn from an instruction, doCall() may push a new frame
+#define DO_CALL(callable, nArgs, ic) do {                       \
+        SAVE_PC();                                              \
+        doCall<INSTRUMENTED>(callable, nArgs, ic);              \
+        LOAD_IP();                                              \
+    } while(0)
+
+// read a CALL_N's CallCache index, then call the fn under its nArgs args
+#define DO_CALL_SITE(nArgs, isTail) do {                        \
+        CallCache* ic = &curFrame->ic[READ_U16()];              \
+        ip += 2;                                                \
+        SAVE_PC();                                              \
+        doCall<INSTRUMENTED>(ppeek(nArgs), nArgs, ic, isTail);  \
+        LOAD_IP();                                              \
+    } while(0)
+
+/*
+  Call the method at cp[U16] of the current fn (see emitSelfCall()). The
+  callable under the args is checked to still be the frame's own fn or
+  closure, a SET! of the fn's name falls back to doCall().
+*/
+#define DO_SELF_CALL(isTail) do {                                       \
+        FnMethod* m = pFnMethod(curFrame->cp[READ_U16()]);              \
+        int nArgs = m->reqArgs();                                       \
+        Closure* closure = curFrame->closure;                           \
+        Obj* self = closure ? static_cast<Obj*>(closure)                \
+            : const_cast<Fn*>(curFrame->fn);                            \
+        ip += 2;                                                        \
+        SAVE_PC();                                                      \
+        if (ppeek(nArgs) == self)                                       \
+            fpush(m, nArgs, isTail ? dropFrame(nArgs) : pc, closure);   \
+        else                                                            \
+            doCall<INSTRUMENTED>(ppeek(nArgs), nArgs, nullptr, isTail); \
+        LOAD_IP();                                                      \
+    } while(0)
+
+#ifdef SXP_THREADED_DISPATCH
+
+// trace, fetch, and jump to the next instruction
+#define DISPATCH() do {                         \
+        if (INSTRUMENTED && rt::vmTrace) {      \
+            SAVE_PC();                          \
+            printTrace();                       \
+        }                                       \
+        oc = *ip++;                             \
+        COUNT(oc);                              \
+        goto *dispatch[oc];                     \
+    } while(0)
+
+/*
+  Each instruction body is wrapped in a switch (0) so the `break' at its end
+  leaves the body's scope normally, running any destructors, and falls into
+  the DISPATCH() in front of the next instruction's label.
+*/
+#define INSTR(id) DISPATCH(); L_##id: switch (0) default:
+
+// jump to a proc's instruction body
 #define GOTO(id) do {                           \
- oc = id;                                       \
- goto NEXTOC;                                   \
- } while(0)
+        oc = id;                                \
+        assert(oc < vasm::PROC_ID_END);         \
+        COUNT(oc);                              \
+        goto *dispatch[oc];                     \
+    } while(0)
+
+#else
+
+#define INSTR(id) case vasm::id:
+
+// jump to a case label in VM::exec()
+#define GOTO(id) do {                           \
+        oc = id;                                \
+        goto NEXTOC;                            \
+    } while(0)
+
+#endif
 
 /*
   Search the frame stack looking for an error handler. Used in the two catches
-  at the end of VM::run(). The printTrace() is necessary because the GOTO skips
-  the test at the top of the VM::vm() method. The `throw e' will occur if
-  there are no methods left in this VM instance.
+  at the end of VM::exec(). The `throw e' will occur if there are no methods
+  left in this VM instance. On return, ip is at the handler and the error is
+  on the stack, above whatever was under the TRY (see vasm::verify()).
  */
 #define HANDLE_ERROR()                                                  \
-    int addr;                                                           \
-    while ((addr = curFrame->method->getHandlerAddr(pc, *sxe)) < 0)     \
+    const ThrowHandler* h;                                              \
+    SAVE_PC();                                                          \
+    while (!(h = curFrame->method->getHandler(pc, *sxe)))               \
         if (fpop(true))                                                 \
             throw e;                                                    \
-    pstack.resize(curFrame->fnIndex + curFrame->method->nLocals());     \
-    pc = addr;                                                          \
+    presize((curFrame->locals - pstack) + curFrame->method->nLocals()   \
+            + h->depth());                                              \
+    pc = h->handlerAddr();                                              \
     ppush(sxe);                                                         \
-    if (rt::vmTrace)                                                    \
-        printTrace();                                                   \
-    GOTO(curFrame->method->bc()[pc++])
+    LOAD_IP()
 
 Obj* VM::run(Obj* fnOrClosure) {
     reset();
     ppush(fnOrClosure);
-    doCall(fnOrClosure, 0);
+    doCall<false>(fnOrClosure, 0);
+    // exec() returns false when it's time to resume in the other variant
+    while (!(rt::vmInstrumented() ? exec<true>() : exec<false>()))
+        ;
+    return ppop();
+}
+
+/*
+  The interpreter loop, instantiated twice. exec<false>() is the production
+  loop, it doesn't trace or count. exec<true>() calls printTrace() before each
+  instruction while rt::vmTrace is set, and keeps VM::stats() while
+  rt::vmStats is set. Execution starts at pc in the current frame. Return
+  true when the bottom frame returns, its result left on the stack, or false
+  if (vm-trace) or (vm-stats) switched which loop should be running, with pc
+  at the next instruction.
+*/
+template <bool INSTRUMENTED>
+bool VM::exec() {
+    const uint8_t* ip = curFrame->code + pc;
     int oc;
+    int prevOc = vasm::HALT;    // for COUNT()
+    (void)prevOc;
+#ifdef SXP_THREADED_DISPATCH
+    static void* dispatch[vasm::PROC_ID_END];
+    if (!dispatch[0]) {
+        std::fill(dispatch, dispatch + vasm::PROC_ID_END, &&ILLEGAL_OPCODE);
+        /*
+          One entry for every INSTR() in the included files below. A name
+          missing from the included files fails to compile, an INSTR()
+          missing from this list warns as an unused label.
+        */
+#define L(id) dispatch[vasm::id] = &&L_##id;
+        L(POP) L(DUP) L(LOAD_NIL) L(LOAD_TRUE) L(LOAD_FALSE)
+        L(LOAD_EMPTY_LIST) L(LOAD_EMPTY_VECTOR) L(LOAD_EMPTY_HASHMAP)
+        L(LOAD_EMPTY_HASHSET) L(NEW_VECTOR) L(NEW_HASHMAP) L(NEW_LIST)
+        L(NEW_HASHSET) L(JUMP) L(JUMP_IF_FALSE)
+        L(LOAD_CONST_0) L(LOAD_CONST_1) L(LOAD_CONST_2) L(LOAD_CONST_3)
+        L(LOAD_CONST_4) L(LOAD_CONST_B) L(LOAD_CONST_S)
+        L(LOAD_LOCAL_0) L(LOAD_LOCAL_1) L(LOAD_LOCAL_2) L(LOAD_LOCAL_3)
+        L(LOAD_LOCAL_4) L(LOAD_LOCAL_B) L(LOAD_LOCAL_S)
+        L(STORE_LOCAL_0) L(STORE_LOCAL_1) L(STORE_LOCAL_2) L(STORE_LOCAL_3)
+        L(STORE_LOCAL_4) L(STORE_LOCAL_B) L(STORE_LOCAL_S)
+        L(LOAD_FREE_0) L(LOAD_FREE_1) L(LOAD_FREE_2) L(LOAD_FREE_3)
+        L(LOAD_FREE_4) L(LOAD_FREE_B)
+        L(STORE_FREE_0) L(STORE_FREE_1) L(STORE_FREE_2) L(STORE_FREE_3)
+        L(STORE_FREE_4) L(STORE_FREE_B) L(LOAD_UPVAL_B) L(STORE_UPVAL_B)
+        L(NEW_CLOSURE) L(DEF) L(VAR_GET)
+        L(CALL_0) L(CALL_1) L(CALL_2) L(CALL_3) L(CALL_4) L(CALL_B)
+        L(CALL_S) L(CALL_PROC) L(CALL_CFN) L(RETURN) L(SET_META) L(APPLY)
+        L(SWAP) L(SWAP2) L(THROW) L(RETHROW) L(VAR_SET) L(JSR) L(RET)
+        L(TAIL_CALL_0) L(TAIL_CALL_1) L(TAIL_CALL_2) L(TAIL_CALL_3)
+        L(TAIL_CALL_4) L(TAIL_CALL_B) L(TAIL_CALL_S)
+        L(SELF_CALL) L(TAIL_SELF_CALL)
+        L(ADD) L(SUB) L(MUL) L(DIV) L(EQEQ) L(LT) L(EQ) L(INC) L(DEC)
+        L(NTH) L(ADD_INT_INT) L(SUB_INT_INT) L(LT_INT_INT) L(EQEQ_INT_INT)
+        L(INC_INT) L(DEC_INT) L(NTH_VECTOR) L(LT_INT_INT_JUMP_IF_FALSE)
+        L(EQEQ_INT_INT_JUMP_IF_FALSE)
+        L(LOAD_VAR) L(LOAD_LOCAL_LOAD_LOCAL) L(LOAD_LOCAL_LOAD_CONST)
+        L(LT_JUMP_IF_FALSE) L(EQEQ_JUMP_IF_FALSE)
+        // procs
+        L(SEQ_1) L(FIRST_1) L(REST_1) L(NEXT_1) L(CONJ_2N) L(LOAD_1)
+        L(CONCAT_0N) L(LIST_0N) L(VECTOR_0N) L(HASHMAP_0N) L(HASHSET_0N)
+        L(TREEMAP_0N) L(TREESET_0N) L(TYPENAME_1) L(EQ_1) L(EQ_2) L(EQ_2N)
+        L(VM_TRACE_0) L(VM_STACK_0) L(VM_STATS_0) L(VM_STATS_PRINT_0)
+        L(GC_BYTES_0) L(COMPILE_1) L(IDENTICAL_P_2)
+        L(META_1) L(WITH_META_2) L(KEY_1) L(VAL_1)
+        L(NS_MAP_1) L(IN_NS_1) L(REFER_1) L(NS_NAME_1) L(FIND_NS_1)
+        L(NS_PUBLICS_1)
+        L(COUNT_1) L(FN_DUMP_1) L(READ_0) L(READ_1) L(READ_3)
+        L(READ_CHAR_1) L(STR_0) L(STR_1) L(STR_1N) L(NTH_2) L(NTH_3)
+        L(GET_2) L(GET_3) L(ASSOC_3N) L(DISSOC_1N) L(MAKE_LAZY_SEQ_1)
+        L(KEYWORD_1) L(SYMBOL_1) L(SYMBOL_2) L(NEXT_ID_0)
+        L(ERROR_0) L(ERROR_1) L(ERROR_2) L(ERR_MSG_1) L(CONTAINS_P_2)
+        L(COPY_1) L(NAME_1)
+        L(RE_MATCH_2) L(RE_MATCH_3) L(RE_MATCH_4) L(RE_PATTERN_1)
+        L(PR_0N) L(NEWLINE_0) L(FSTREAM_1N) L(SSTREAM_0) L(SSTREAM_1N)
+        L(FCLOSE_1) L(SLURP_1) L(READ_LINE_0)
+        L(PUSH_BINDINGS_1) L(POP_BINDINGS_0) L(MACROEXPAND_1_1) L(IR_1)
+        L(SEQ_P_1) L(SEQABLE_P_1) L(NUMBER_P_1) L(INDEXED_P_1)
+        L(COLLECTION_P_1) L(ASSOCIATIVE_P_1) L(SORTABLE_P_1) L(STREAM_P_1)
+        L(INSTREAM_P_1) L(OUTSTREAM_P_1) L(SET_P_1)
+        L(ERROR_P_1) L(IO_ERROR_P_1) L(BOOL_P_1) L(CFN_P_1)
+        L(CHARACTER_P_1) L(CLOSURE_P_1) L(FLOAT_P_1) L(FN_P_1)
+        L(FSTREAM_P_1) L(HASHMAP_P_1) L(HASHSET_P_1) L(INTEGER_P_1)
+        L(KEYWORD_P_1) L(LIST_P_1) L(MAP_P_1) L(MAPENTRY_P_1)
+        L(NAMESPACE_P_1) L(PROC_P_1) L(REGEX_P_1) L(SSTREAM_P_1)
+        L(STRING_P_1) L(SYMBOL_P_1) L(TREEMAP_P_1) L(TREESET_P_1)
+        L(VAR_P_1) L(VECTOR_P_1)
+        L(INT_1) L(FLOAT_1)
+        L(ADD_0) L(ADD_1) L(ADD_2) L(ADD_2N) L(SUB_1) L(SUB_2) L(SUB_2N)
+        L(MUL_0) L(MUL_1) L(MUL_2) L(MUL_2N) L(DIV_1) L(DIV_2) L(DIV_2N)
+        L(EQEQ_1) L(EQEQ_2) L(EQEQ_2N) L(LT_1) L(LT_2) L(LT_2N)
+        L(INC_1) L(DEC_1)
+#undef L
+    }
+#endif
     while (true) {
-        if (rt::vmTrace)         // the order of these statements matters
-            printTrace();        // ...
-        oc = curFrame->bc[pc++]; // because of the p++ post increment
-    NEXTOC:
-        assert(pc <= 0xffff);
-        ++_nInstructions;
+        /*
+          The try is entered once per error handled, not once per
+          instruction. After a handler is found, ip is at its first
+          instruction, so loop back around and resume dispatching.
+        */
         try {
-            switch (oc) {
+#ifndef SXP_THREADED_DISPATCH
+            while (true) {
+                if (INSTRUMENTED && rt::vmTrace) {
+                    SAVE_PC();
+                    printTrace();
+                }
+                oc = *ip++;
+            NEXTOC:
+                COUNT(oc);
+                switch (oc) {
+#endif
 #include "instr_8.cpp"
 #include "instr_16.cpp"
 #include "proc_ns.cpp"
@@ -244,7 +680,13 @@ Obj* VM::run(Obj* fnOrClosure) {
 #include "proc_error.cpp"
 #include "proc_predicate.cpp"
 #include "proc_re.cpp"
+#ifdef SXP_THREADED_DISPATCH
+            DISPATCH();
+            ILLEGAL_OPCODE: {
+#else
                 default: {
+#endif
+                    SAVE_PC();
                     curFrame->fn->dump();
                     printStack();
                     std::cerr << "PC: " << HEX4(pc) << std::endl;
@@ -255,9 +697,11 @@ Obj* VM::run(Obj* fnOrClosure) {
                     else
                         ss << HEX2(oc);
                     throw SxRuntimeError(ss.str());
-                    break;
+                }
+#ifndef SXP_THREADED_DISPATCH
                 }
             }
+#endif
         }
         catch (SxError& e) {
             SxError* sxe = e.clone(e.what());
@@ -272,5 +716,15 @@ Obj* VM::run(Obj* fnOrClosure) {
 }
 
 #undef READ_U16
+#undef SAVE_PC
+#undef LOAD_IP
+#undef COUNT
+#undef QUICKEN
+#undef DEOPT
+#undef DO_CALL
+#undef DO_CALL_SITE
+#undef DO_SELF_CALL
+#undef INSTR
+#undef DISPATCH
 #undef GOTO
 #undef HANDLE_ERROR
@@ -7,23 +7,61 @@
 #ifndef VM_HPP_INCLUDED
 #define VM_HPP_INCLUDED
 
+struct ArgSeq;
 
-struct Frame;
+// One activation record. These live by value in VM::fstack, which is reused
+// from call to call, so a call or return allocates nothing.
+struct Frame {
+    const Fn* fn;            // method's parent function
+    const FnMethod* method;  // method currently being executed
+    const uint8_t* code;     // method's bytecode, VM::exec() ip base
+    Obj* const* cp;          // fn's constant pool
+    Obj** locals;            // pstack address of fn
+    uint16_t retAddr;        // the addr of the next instruction of the caller
+    Closure* closure;
+    int fnIndex;                // pstack index the frame pops to
+    CallCache* ic;              // method's call site caches
+};
+
+// Counters kept by the instrumented VM::exec() loop, see (vm-stats)
+struct VMStats {
+    long nInstructions;
+    long opcodes[vasm::PROC_ID_END]; // executions per opcode and proc id
+    long icHits;                     // CALL_N inline cache hits
+    long icMisses;                   // and misses
+    long pairs[256][256];            // [previous opcode][opcode] executions
+    long quickened[256];             // rewrites to an opcode, see QUICKEN()
+    long deopts[256];                // and rewrites from it, see DEOPT()
+    long closures;                   // made by NEW_CLOSURE
+    long closureVals;                // and the values copied into them
+    long closureUpvals;              // and the Upvals they share
+    void print(std::ostream&) const;
+};
 
 struct VM {
-    VM();
-    ~VM();
     Obj* run(Obj*);
-    static long nInstructions() { return _nInstructions; }
+    static VMStats& stats() { return _stats; }
+    static VM* acquire();
+    static void release(VM*);
 protected:
+    static constexpr int INIT_PSTACK_SIZE = 1024;
     static constexpr int MAX_PSTACK_SIZE = 512000;
+    static constexpr int INIT_FSTACK_SIZE = 256;
+    static constexpr int MAX_FSTACK_SIZE = MAX_PSTACK_SIZE;
     int pc;                     // program counter
-    vecobj_t pstack;            // parameter stack
+    Obj** pstack;               // parameter stack, see reserve()
+    Obj** sp;                   // one past its top
+    Obj** pstackEnd;            // one past its last slot
     Frame* curFrame = nullptr;  // currently executing method frame
-    std::vector<Frame*, gc_allocator<Frame*>> fstack; // frame stack
+    std::vector<Frame, gc_allocator<Frame>> fstack; // frame stack, see fpush()
+    int fsp;                    // number of frames in use in fstack
     Upval* openUpvals;                                // ???
+    ArgSeq* openArgs;           // rest args still on pstack, see doCall()
+    ArgSeq* procArgs;           // the one reused for every Proc's rest arg
     std::vector<uint16_t> jstack;
-    static long _nInstructions;
+    static VMStats _stats;
+    static std::vector<VM*, gc_allocator<VM*>> _pool; // idle VMs
+    VM();
     void jpush(uint16_t addr) {
         std::cout << "JPUSH: " << HEX4(addr) << std::endl;
         jstack.push_back(addr);
@@ -34,17 +72,35 @@ protected:
         jstack.pop_back();
         return addr;
     }
+    template <bool INSTRUMENTED> bool exec();
     void reset();
     void ppush(Obj*);
     Obj* ppop();
     Obj* ppeek(int i=0);
-    void fpush(FnMethod*, int, int, Closure*);
+    int pdepth() const { return sp - pstack; }
+    void presize(size_t);
+    void reserve(size_t);
+    void growPstack(size_t);
+    void fpush(FnMethod*, int, int, Closure*, int);
     int fpop(bool isThrow = false);
-    void doCall(Obj*, int);
+    template <bool INSTRUMENTED>
+    void doCall(Obj*, int, CallCache* ic = nullptr, bool isTail = false);
+    int dropFrame(int);
     void printTrace();
     Upval* captureUpval(uint8_t index);
     void closeUpvals(Obj** lastAddr);
+    void closeArgs(Obj** lastAddr);
     void printStack(std::ostream&);
 };
 
+// A VM borrowed from the pool for the life of the scope
+struct PooledVM {
+    PooledVM() : _vm(VM::acquire()) {}
+    ~PooledVM() { VM::release(_vm); }
+    PooledVM(const PooledVM&) = delete;
+    VM* operator->() { return _vm; }
+private:
+    VM* _vm;
+};
+
 #endif // VM_HPP_INCLUDED
@@ -11,66 +11,74 @@ struct Obj;
 struct Hashmap;
 
 struct IMeta : virtual Obj {
+    IMeta() { _ifaces |= IF_IMeta; }
     // TODO: bool hasMeta() = 0;
     virtual Hashmap* meta() = 0;
     virtual Obj* withMeta(Hashmap*) = 0;
 };
-DEF_CASTER(IMeta)
+DEF_XFACE_CASTER(IMeta)
 
 struct ISeq : virtual Obj {
+    ISeq() { _ifaces |= IF_ISeq; }
     virtual Obj* first() = 0;
     virtual ISeq* rest() = 0;
     virtual ISeq* next() = 0;
     virtual ISeq* cons(Obj*) = 0;
 };
-DEF_CASTER(ISeq)
+DEF_XFACE_CASTER(ISeq)
 
 struct ISeqable : virtual Obj {
+    ISeqable() { _ifaces |= IF_ISeqable; }
     virtual ISeq* seq() = 0;
 };
-DEF_CASTER(ISeqable)
+DEF_XFACE_CASTER(ISeqable)
 
 struct INumber : virtual Obj {
+    INumber() { _ifaces |= IF_INumber; }
     virtual long toInt() = 0;
     virtual double toFloat() = 0;
-    virtual INumber* add(INumber*) = 0;
-    virtual INumber* sub(INumber*) = 0;
-    virtual INumber* mul(INumber*) = 0;
-    virtual INumber* div(INumber*) = 0;
-    virtual INumber* neg() = 0;
+    virtual Obj* add(INumber*) = 0;
+    virtual Obj* sub(INumber*) = 0;
+    virtual Obj* mul(INumber*) = 0;
+    virtual Obj* div(INumber*) = 0;
+    virtual Obj* neg() = 0;
     virtual bool eq(INumber*) = 0; // (== x & xs) numerical equality
     virtual bool lt(INumber*) = 0;
 };
-DEF_CASTER(INumber)
+DEF_XFACE_CASTER(INumber)
 
 struct IIndexed : virtual Obj {
+    IIndexed() { _ifaces |= IF_IIndexed; }
     virtual Obj* nth(int) = 0;
     virtual Obj* nth(int, Obj*) = 0;
 };
-DEF_CASTER(IIndexed)
+DEF_XFACE_CASTER(IIndexed)
 
 struct ICollection : virtual Obj {
+    ICollection() { _ifaces |= IF_ICollection; }
     virtual int count() = 0;
     virtual bool isEmpty() = 0;
     virtual ICollection* conj(Obj*) = 0;
 };
-DEF_CASTER(ICollection)
+DEF_XFACE_CASTER(ICollection)
 
 struct MapEntry;
 
 struct IAssociative : virtual Obj {
+    IAssociative() { _ifaces |= IF_IAssociative; }
     virtual IAssociative* assoc(Obj*, Obj*) = 0;
     virtual IAssociative* dissoc(Obj*) = 0;
     virtual bool hasKey(Obj*) = 0;
     virtual MapEntry* entryAt(Obj*) = 0;
     virtual Obj* valAt(Obj*, Obj* notFound=NIL) = 0;
 };
-DEF_CASTER(IAssociative)
+DEF_XFACE_CASTER(IAssociative)
 
 struct ISortable : virtual Obj {
+    ISortable() { _ifaces |= IF_ISortable; }
     virtual bool less(Obj*) = 0;
 };
-DEF_CASTER(ISortable)
+DEF_XFACE_CASTER(ISortable)
 
 // =========================================================================
 // IO Streams
@@ -78,21 +86,24 @@ DEF_CASTER(ISortable)
 typedef std::ios_base::openmode openMode_t;
 
 struct IStream : virtual Obj {
+    IStream() { _ifaces |= IF_IStream; }
     virtual openMode_t mode() = 0;
     virtual bool eof() = 0;
     virtual void close() = 0;
 };
-DEF_CASTER(IStream)
+DEF_XFACE_CASTER(IStream)
 
 struct IInStream : IStream {
+    IInStream() { _ifaces |= IF_IInStream; }
     virtual int get() = 0;
     virtual int peek() = 0;
     virtual void unget() = 0;
     virtual std::istream& istream() = 0;
 };
-DEF_CASTER(IInStream)
+DEF_XFACE_CASTER(IInStream)
 
 struct IOutStream : IStream {
+    IOutStream() { _ifaces |= IF_IOutStream; }
     virtual void put(int c) = 0;
     virtual void flush() = 0;
     virtual void print(Obj*) = 0;
@@ -101,13 +112,14 @@ struct IOutStream : IStream {
     virtual void println(const std::string&) = 0;
     virtual std::ostream& ostream() = 0;
 };
-DEF_CASTER(IOutStream)
+DEF_XFACE_CASTER(IOutStream)
 
 struct ISet : virtual Obj {
+    ISet() { _ifaces |= IF_ISet; }
     virtual ISet* disjoin(Obj*) = 0;
     virtual bool contains(Obj*) = 0;
     virtual Obj* get(Obj*, Obj* notFound=NIL) = 0;
 };
-DEF_CASTER(ISet)
+DEF_XFACE_CASTER(ISet)
 
 #endif // XFACE_HPP_INCLUDED